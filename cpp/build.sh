@@ -10,6 +10,7 @@ usage() {
   clean  : Remove build dir.
   prof   : Compile with profiling enabled (slower).
   lib    : Build & run lib tests.
+  bench  : Build & run benchmarks.
   travis : Run tests.
   *      : Problem number, build & run that problem. Use leading 0 for < 10. Example 03 -> runs Euler003.exe"
 }
@@ -93,6 +94,12 @@ while (( $# > 0 )); do
       build
       "$BDIR/util/LibTest.exe"
       ;;
+    bench)
+      build
+      for bench in "$BDIR/src/Bench"*; do
+        "$bench" --gtest_filter='Bench*'
+      done
+      ;;
     travis)
       build
       travis_tests
@@ -37,10 +37,12 @@ direction (up, down, left, right, or diagonally) in the 20×20 grid?
 #include <vector>
 #include <algorithm>
 #include <exception>
+#include <stdexcept>
 
 #include "boost/smart_ptr/shared_ptr.hpp"
 #include "gtest/gtest.h"
 #include "util.hpp"
+#include "matrix_file.hpp"
 
 /**************** Namespace Declarations ******************/
 using std::cout;
@@ -100,16 +102,13 @@ class Grid {
 public:
     Grid(const std::string &file, grid_ind nrows,
             grid_ind ncols) : nrows(nrows), ncols(ncols) {
-        std::ifstream fin(file.c_str());
-        u_shrt val = 0;
-
-        while (rows.size() != nrows) {
-            row_t row;
-            while (row.size() != ncols) {
-                fin >> val;
-                row.push_back(val);
-            }
-            rows.push_back(row);
+        util::Matrix<int> matrix = util::load_matrix(file);
+        if (matrix.rows() != nrows || matrix.cols() != ncols) {
+            throw std::runtime_error("Grid file has the wrong dimensions: " + file);
+        }
+
+        for (grid_ind row = 0; row < nrows; ++row) {
+            rows.push_back(row_t(matrix.row(row), matrix.row(row) + ncols));
         }
     }
 
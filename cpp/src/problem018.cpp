@@ -18,6 +18,7 @@ in matrix.txt (right click and "Save Link/Target As..."), a 31K text file contai
 
 #include "gtest/gtest.h"
 #include "util.hpp"
+#include "matrix_file.hpp"
 
 /**************** Namespace Declarations ******************/
 using std::cout;
@@ -26,160 +27,71 @@ using std::endl;
 /************** Global Vars & Functions *******************/
 static const std::string INPUT = "./src/input_e018.txt";
 
-class Node;
-class Node {
-public:
-    explicit Node(int value = 0) : value(value) {}
-
-    friend std::ostream & operator<<(std::ostream& os, const Node &node);
-
-    // Data
-    int value = 0;
-    Node *left = NULL;
-    Node *right = NULL;
-};
-// 2d node holder while linking
-typedef std::vector<std::vector<Node> > vec_node_t;
-
-std::ostream & operator<<(std::ostream &os, const Node &node) {
-    int left = 0;
-    int right = 0;
-    if (node.left != NULL) {
-        left = node.left->value;
-    }
-    if (node.right != NULL) {
-        right = node.right->value;
-    }
-    os << "Node: " << node.value
-        << " L(" << left << ") R(" << right << ")";
-
-    return os;
-}
-/*
- * Debug only, prints whole matrix of nodes.
- */
-void print_nodes(const vec_node_t &all_nodes) {
-    for (auto row : all_nodes) {
-        for (auto node : row) {
-            cout << node << endl;
-        }
-    }
-}
+typedef util::Triangle<int> triangle_t;
 
 /*
- * Read in the value of a node and connect it right and down if required.
+ * Debug only, prints the whole triangle.
  */
-void read_nodes(const std::string &line, vec_node_t &nodes) {
-    std::stringstream ss(line);
-    std::vector<Node> row;
-    while (ss) {
-        Node node;
-        ss >> node.value;
-        if (node.value) {
-            row.push_back(node);
+void print_triangle(const triangle_t &triangle) {
+    for (std::size_t row = 0; row < triangle.rows(); ++row) {
+        for (std::size_t col = 0; col <= row; ++col) {
+            cout << triangle(row, col) << " ";
         }
-    }
-
-    nodes.push_back(row);
-}
-
-/*
- * Read all nodes from file into nodes.
- * Ensure connections setup too.
- */
-void read_in_nodes(vec_node_t &nodes) {
-    std::ifstream input(INPUT, std::ifstream::in);
-    std::string line;
-    while (std::getline(input, line)) {
-        read_nodes(line, nodes);
-    }
-}
-
-void connect_paths(vec_node_t &nodes) {
-    auto cur_row = nodes.begin();
-    auto next_row = nodes.begin();
-
-    // next_row always pointing at one row beyond cur_row
-    while (++next_row != nodes.end()) {
-        int cnt = 0;
-        for (Node &node: *cur_row) {
-            node.left = &next_row->at(cnt);
-            node.right = &next_row->at(cnt + 1);
-            cnt++;
-        }
-
-        cur_row++;
+        cout << endl;
     }
 }
 
 // Naieve implementation
-int check_nodes_recursion(const Node &node) {
-    if (node.left == NULL && node.right == NULL) {
-        return node.value;
+int check_nodes_recursion(const triangle_t &triangle, std::size_t row = 0, std::size_t col = 0) {
+    if (row + 1 == triangle.rows()) {
+        return triangle(row, col);
     }
 
-    return node.value + std::max(check_nodes_recursion(*node.left),
-                                 check_nodes_recursion(*node.right));
+    return triangle(row, col) + std::max(check_nodes_recursion(triangle, row + 1, col),
+                                         check_nodes_recursion(triangle, row + 1, col + 1));
 }
 
-// Memo implementation
-int check_nodes_memo(const Node &node, std::map<const Node*, int> &memo) {
-    if (memo[&node] != 0) {
-        return memo[&node];
+// Memo implementation, memo is a side triangle of best sums with 0 for unknown.
+int check_nodes_memo(const triangle_t &triangle, triangle_t &memo,
+        std::size_t row = 0, std::size_t col = 0) {
+    if (memo(row, col) != 0) {
+        return memo(row, col);
     }
 
-    if (node.left == NULL && node.right == NULL) {
-        return node.value;
+    if (row + 1 == triangle.rows()) {
+        return triangle(row, col);
     }
 
-    memo[&node] = node.value + std::max(check_nodes_memo(*node.left, memo),
-                                        check_nodes_memo(*node.right, memo));
-    return memo[&node];
+    memo(row, col) = triangle(row, col) + std::max(check_nodes_memo(triangle, memo, row + 1, col),
+                                                   check_nodes_memo(triangle, memo, row + 1, col + 1));
+    return memo(row, col);
 }
 
-TEST(Euler018, ReadNodes) {
-    vec_node_t nodes;
-    read_nodes(std::string("33 22 11"), nodes);
-    ASSERT_EQ(nodes.front().front().value, 33);
-    ASSERT_EQ(nodes.back().back().value, 11);
+TEST(Euler018, ReadTriangle) {
+    triangle_t triangle = util::load_triangle(INPUT);
+    ASSERT_EQ(triangle[0], 75);
+    ASSERT_EQ(triangle[triangle.size() - 1], 23);
 }
 
-TEST(Euler018, ReadInNodes) {
-    vec_node_t nodes;
-    read_in_nodes(nodes);
-    ASSERT_EQ(nodes.front().front().value, 75);
-    ASSERT_EQ(nodes.back().back().value, 23);
-}
-
-TEST(Euler018, ConnectLinks) {
-    vec_node_t nodes;
-    read_in_nodes(nodes);
-    connect_paths(nodes);
-
-    Node front = nodes.front().front();
-    ASSERT_EQ(front.left->value, 95);
-    ASSERT_EQ(front.right->value, 64);
+TEST(Euler018, Below) {
+    triangle_t triangle = util::load_triangle(INPUT);
+    ASSERT_EQ(triangle(1, 0), 95);
+    ASSERT_EQ(triangle(1, 1), 64);
 }
 
 TEST(Euler018, CheckNodesRecursion) {
-    vec_node_t nodes;
-    read_in_nodes(nodes);
-    connect_paths(nodes);
-    const Node &node = nodes.front().front();
+    triangle_t triangle = util::load_triangle(INPUT);
 
-    int max_total = check_nodes_recursion(node);
+    int max_total = check_nodes_recursion(triangle);
     cout << "The max value found going down: " << max_total << endl;
     ASSERT_EQ(max_total, 1074);
 }
 
 TEST(Euler018, CheckNodesMemo) {
-    vec_node_t nodes;
-    read_in_nodes(nodes);
-    connect_paths(nodes);
-    const Node &node = nodes.front().front();
-    std::map<const Node*, int> memo;
+    triangle_t triangle = util::load_triangle(INPUT);
+    triangle_t memo(triangle.rows());
 
-    int max_total = check_nodes_memo(node, memo);
+    int max_total = check_nodes_memo(triangle, memo);
     cout << "The max value found going down: " << max_total << endl;
     ASSERT_EQ(max_total, 1074);
 }
@@ -39,9 +39,19 @@ How many hands does Player 1 win?
 #include <map>
 #include <set>
 #include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <cstdio>
+#include <cstdint>
+#include <memory>
 
 #include "gtest/gtest.h"
 #include "util.hpp"
+#include "poker.hpp"
+#include "hand_log.hpp"
+#include "preflop.hpp"
+#include "draw.hpp"
 
 /**************** Namespace Declarations ******************/
 using std::cout;
@@ -50,6 +60,8 @@ using std::endl;
 /************** Global Vars & Functions *******************/
 typedef int num_t;
 static const std::string INPUT = "./src/input_e054.txt";
+// Top card of A 2 3 4 5, the ace plays low.
+static const num_t WHEEL_HIGH = 5;
 
 enum Suits {
     Hearts,
@@ -144,6 +156,10 @@ public:
     inline std::string text_value() const { return value_to_face[this->value]; };
     inline std::string text_suit() const { return suit_to_text[this->suit]; };
     inline std::string to_text() const { return this->text_value() + this->text_suit(); };
+    // Same card for the util::poker evaluator, whose ranks start at the deuce.
+    inline util::poker::card_t packed() const {
+        return util::poker::make_card(this->value - 2, this->suit);
+    }
 
     bool operator==(const Card &other) const {
         return this->value == other.value &&
@@ -377,10 +393,30 @@ public:
 
         } while (++offset != 4);
 
-        // FIXME: Solution would require some tie state
-        // I call a tie a loss, input states no absolute ties so fine.
+        // An absolute tie isn't a win, see showdown() for split pots.
         return false;
     }
+    // Comparable key of a ranked hand, higher wins & equal is an absolute tie.
+    // Layout: type, rank value (composites reach 1414) then every card high to low.
+    // Once type & value match the grouped cards match, so only kickers decide.
+    std::uint64_t strength() const {
+        std::uint64_t key = this->rank.type;
+        key = (key << 12) | this->rank.value;
+        for (auto iter = cards.crbegin(); iter != cards.crend(); ++iter) {
+            key = (key << 4) | iter->value;
+        }
+
+        return key;
+    }
+    // Cards in hand order for the util::poker code, i.e. draw hold masks follow this order.
+    std::vector<util::poker::card_t> packed() const {
+        std::vector<util::poker::card_t> packed;
+        for (const Card &card : this->cards) {
+            packed.push_back(card.packed());
+        }
+
+        return packed;
+    }
     // Scan down cards, return first unselected one, 0 if none left
     num_t unselected_card(int offset = 0) const {
         auto iter = cards.crbegin();
@@ -428,6 +464,31 @@ public:
     Ranking rank;
 };
 
+/*
+ * Settle a pot among any number of hands, ranking each unranked hand once.
+ * Returns the indices of every hand sharing the best strength, more than one is a split.
+ */
+std::vector<std::size_t> showdown(std::vector<Hand> &hands) {
+    std::vector<std::size_t> winners;
+    std::uint64_t best = 0;
+    for (std::size_t i = 0; i < hands.size(); ++i) {
+        if (hands[i].rank.type == HandTypes::Unranked) {
+            hands[i].detect_ranking();
+        }
+
+        std::uint64_t strength = hands[i].strength();
+        if (winners.empty() || strength > best) {
+            best = strength;
+            winners.clear();
+            winners.push_back(i);
+        } else if (strength == best) {
+            winners.push_back(i);
+        }
+    }
+
+    return winners;
+}
+
 // Hands must be 5 cards in size, simply update hand once at size.
 std::istream& Hand::read_cards(std::istream &is) {
     while (cards.size() != 5) {
@@ -524,10 +585,37 @@ bool detect_royal_flush(Hand &hand) {
     return true;
 }
 
+// Cards sorted so A 2 3 4 5 reads 2 3 4 5 A.
+bool is_wheel(const Hand &hand) {
+    return hand.cards[0].value == 2 && hand.cards[1].value == 3 &&
+        hand.cards[2].value == 4 && hand.cards[3].value == 5 &&
+        hand.cards[4].value == 14;
+}
+
+// Group is valued by its last card, the low ace would make it 14.
+void add_wheel(Hand &hand, HandTypes type) {
+    hand.rank.add_group(
+        CardGroup(type).add_all(
+        hand.cards.begin(), hand.cards.end())
+    );
+    hand.rank.value = WHEEL_HIGH;
+}
+
 bool detect_straight_flush(Hand &hand) {
     auto iter = hand.cards.cbegin();
     Card expect(*iter);
 
+    if (is_wheel(hand)) {
+        while (++iter != hand.cards.cend()) {
+            if (iter->suit != expect.suit) {
+                return false;
+            }
+        }
+
+        add_wheel(hand, HandTypes::StraightFlush);
+        return true;
+    }
+
     while (++iter != hand.cards.cend()) {
         expect.value += 1;
         if (*iter != expect) {
@@ -563,6 +651,11 @@ bool detect_straight(Hand &hand) {
     auto iter = hand.cards.cbegin();
     Card expect(*iter);
 
+    if (is_wheel(hand)) {
+        add_wheel(hand, HandTypes::Straight);
+        return true;
+    }
+
     while (++iter != hand.cards.cend()) {
         expect.value += 1;
         if (iter->value != expect.value) {
@@ -670,6 +763,11 @@ int number_won_hands() {
     return player_1_won;
 }
 
+// Same count through the memory mapped, chunk parallel reader for big logs.
+int number_won_hands_parallel(unsigned threads = 0, const std::string &fname = INPUT) {
+    return util::poker::tally_log(fname, threads).wins[0];
+}
+
 ////////////
 // Test Code
 ////////////
@@ -742,6 +840,12 @@ TEST(E054_Card, LessOperator) {
     ASSERT_TRUE(nine_hearts < nine);
 }
 
+TEST(E054_Card, Packed) {
+    ASSERT_EQ(Card("TD").packed(), util::poker::parse_card("TD"));
+    ASSERT_EQ(Card("2H").packed(), util::poker::parse_card("2H"));
+    ASSERT_EQ(Card("AS").packed(), util::poker::parse_card("AS"));
+}
+
 TEST(E054_Card, TextValue) {
     Card card("TD");
     ASSERT_EQ(card.text_value(), std::string("T"));
@@ -1001,6 +1105,49 @@ TEST(E054_Hand, BreakTie) {
     hand.detect_ranking();
 }
 
+TEST(E054_Hand, Strength) {
+    Hand hand(1), hand2(2);
+    std::stringstream ss(HAND_PLAYER_1_TIE_BREAK);
+    ss >> hand >> hand2;
+    hand.detect_ranking();
+    hand2.detect_ranking();
+    ASSERT_GT(hand.strength(), hand2.strength());
+
+    // Same high card, beats() only looks at the top of a flush.
+    ss = std::stringstream("2H 6H 9H QH AH 3D 6D 9D QD AD");
+    ss >> hand >> hand2;
+    hand.detect_ranking();
+    hand2.detect_ranking();
+    ASSERT_LT(hand.strength(), hand2.strength());
+
+    ss = std::stringstream("2H 2D 4S 4C KC 2C 2S 4H 4D KH");
+    ss >> hand >> hand2;
+    hand.detect_ranking();
+    hand2.detect_ranking();
+    ASSERT_EQ(hand.strength(), hand2.strength());
+}
+
+TEST(E054_Hand, DrawOptions) {
+    Hand hand;
+    std::stringstream("TH JH QH KH KS") >> hand;
+    std::vector<util::poker::card_t> packed = hand.packed();
+    ASSERT_EQ(packed.size(), 5);
+
+    unsigned hearts = 0;
+    for (std::size_t i = 0; i < hand.cards.size(); ++i) {
+        if (hand.cards[i].suit == Suits::Hearts) {
+            hearts |= 1u << i;
+        }
+    }
+    std::vector<double> royal_only(util::poker::NUM_CATEGORIES, 0.0);
+    royal_only[util::poker::RoyalFlush] = 1.0;
+    util::poker::DrawSolver solver;
+    std::vector<util::poker::DrawOption> options = solver.solve(packed);
+    ASSERT_EQ(util::poker::best_hold(options, royal_only), hearts);
+    ASSERT_EQ(options[hearts].categories[util::poker::RoyalFlush], 1);
+    ASSERT_EQ(options[hearts].categories[util::poker::Flush], 7);
+}
+
 TEST(E054_Hand, UnselectedCard) {
     Hand hand;
     std::stringstream(HAND_ONE_PAIR) >> hand;
@@ -1021,6 +1168,33 @@ TEST(E054_Hand, Resetselections) {
     }
 }
 
+TEST(E054_Showdown, SingleWinner) {
+    std::vector<Hand> hands(3);
+    std::stringstream ss(HAND_ONE_PAIR + " " + HAND_FULL_HOUSE + " " + HAND_STRAIGHT);
+    ss >> hands[0] >> hands[1] >> hands[2];
+    std::vector<std::size_t> expect = {1};
+    ASSERT_EQ(showdown(hands), expect);
+}
+
+TEST(E054_Showdown, SplitPot) {
+    std::vector<Hand> hands(4);
+    std::stringstream ss("2H 2D 4S 4C KC 2C 2S 4H 4D KH 3H 3D 6S 6C JC 7H 7D 8H 8C KS");
+    ss >> hands[0] >> hands[1] >> hands[2] >> hands[3];
+    std::vector<std::size_t> expect = {3};
+    ASSERT_EQ(showdown(hands), expect);
+
+    ss = std::stringstream("2H 2D 4S 4C KC 2C 2S 4H 4D KH 3H 3D 9S 8C QC");
+    hands.resize(3);
+    ss >> hands[0] >> hands[1] >> hands[2];
+    expect = {0, 1};
+    ASSERT_EQ(showdown(hands), expect);
+}
+
+TEST(E054_Showdown, Empty) {
+    std::vector<Hand> hands;
+    ASSERT_TRUE(showdown(hands).empty());
+}
+
 // To debug detectors ....
 //cout << "Read hand" << endl << hand << endl << hand2 << endl;
 TEST(E054_DetectCards, HighCard) {
@@ -1144,6 +1318,26 @@ TEST(E054_DetectCards, StraightFlush) {
     ASSERT_FALSE(detect_straight_flush(hand2));
 }
 
+TEST(E054_DetectCards, Wheel) {
+    Hand hand(1), hand2(2);
+    std::stringstream ss(std::string("AH 2D 3S 4C 5C") + " " + HAND_STRAIGHT);
+    ss >> hand >> hand2;
+    hand.detect_ranking();
+    hand2.detect_ranking();
+    ASSERT_EQ(hand.rank.type, HandTypes::Straight);
+    ASSERT_EQ(hand.rank.value, 5);
+    ASSERT_TRUE(hand2.beats(hand));
+}
+
+TEST(E054_DetectCards, SteelWheel) {
+    Hand hand(1);
+    std::stringstream ss(std::string("AH 2H 3H 4H 5H"));
+    ss >> hand;
+    ASSERT_TRUE(detect_straight_flush(hand));
+    ASSERT_EQ(hand.rank.type, HandTypes::StraightFlush);
+    ASSERT_EQ(hand.rank.value, 5);
+}
+
 TEST(E054_DetectCards, RoyalFlush) {
     Hand hand(1), hand2(2);
     std::stringstream ss(HAND_ROYAL_FLUSH + " " + HAND_STRAIGHT);
@@ -1161,3 +1355,230 @@ TEST(Euler054, NumberWonHands) {
     ASSERT_EQ(result, 376);
     cout << "The number of hands player 1 won is: " << result << endl;
 }
+
+TEST(Euler054, NumberWonHandsParallel) {
+    for (unsigned threads : {1, 4}) {
+        ASSERT_EQ(number_won_hands_parallel(threads), 376);
+    }
+}
+
+TEST(Euler054, PackedAgreesWithHand) {
+    Hand hand(1), hand2(2);
+    std::ifstream input(INPUT, std::ifstream::in);
+    std::string line;
+    int lines = 0;
+    while (std::getline(input, line)) {
+        std::stringstream(line) >> hand >> hand2;
+        hand.detect_ranking();
+        hand2.detect_ranking();
+
+        util::poker::strength_t strengths[2];
+        for (const Hand *cur : {&hand, &hand2}) {
+            std::vector<util::poker::card_t> packed;
+            for (const Card &card : cur->cards) {
+                packed.push_back(card.packed());
+            }
+            strengths[cur->player - 1] = util::poker::evaluate(packed);
+            ASSERT_EQ(util::poker::category(strengths[cur->player - 1]), cur->rank.type);
+        }
+        ASSERT_EQ(strengths[0] > strengths[1], hand.beats(hand2));
+        ASSERT_EQ(strengths[0] > strengths[1], hand.strength() > hand2.strength());
+        ASSERT_EQ(strengths[0] == strengths[1], hand.strength() == hand2.strength());
+        lines++;
+    }
+    ASSERT_EQ(lines, 1000);
+}
+
+#ifdef BENCH
+////////////
+// Benchmarks, only built into Bench054.exe
+////////////
+typedef std::vector<num_t> histogram_t;
+static const num_t ALL_HANDS = 2598960;
+// Count of every HandTypes over all 5 card hands, indexed by type.
+static const histogram_t ALL_HANDS_HISTOGRAM = {
+    0,  // Unranked
+    1302540,
+    1098240,
+    123552,
+    54912,
+    10200,
+    5108,
+    3744,
+    624,
+    36,
+    4,  // RoyalFlush, with above 40 straight flushes
+};
+
+// Visit every 5 card combination of a 52 card deck by index, return seconds taken.
+template <class Visitor>
+double time_all_hands(Visitor visit) {
+    auto start = std::chrono::steady_clock::now();
+    for (int a = 0; a < 48; ++a) {
+        for (int b = a + 1; b < 49; ++b) {
+            for (int c = b + 1; c < 50; ++c) {
+                for (int d = c + 1; d < 51; ++d) {
+                    for (int e = d + 1; e < 52; ++e) {
+                        visit(a, b, c, d, e);
+                    }
+                }
+            }
+        }
+    }
+    std::chrono::duration<double> taken = std::chrono::steady_clock::now() - start;
+
+    return taken.count();
+}
+
+void print_rate(const std::string &name, double seconds) {
+    cout << std::left << std::setw(28) << name << std::right << std::setw(10)
+        << std::fixed << std::setprecision(3) << seconds << " s "
+        << std::setw(14) << std::setprecision(0) << ALL_HANDS / seconds << " hands/sec" << endl;
+}
+
+TEST(Bench054, AllFiveCardHands) {
+    std::vector<Card> deck;
+    std::vector<util::poker::card_t> packed_deck;
+    for (num_t value = 2; value <= 14; ++value) {
+        for (Suits suit : {Suits::Hearts, Suits::Diamonds, Suits::Clubs, Suits::Spades}) {
+            Card card;
+            card.value = value;
+            card.suit = suit;
+            deck.push_back(card);
+            packed_deck.push_back(card.packed());
+        }
+    }
+
+    histogram_t legacy(ALL_HANDS_HISTOGRAM.size());
+    Hand hand;
+    double legacy_secs = time_all_hands([&](int a, int b, int c, int d, int e) {
+        hand.cards = {deck[a], deck[b], deck[c], deck[d], deck[e]};
+        hand.sort();
+        hand.rank = Ranking();
+        hand.detect_ranking();
+        ++legacy[hand.rank.type];
+    });
+
+    histogram_t packed(ALL_HANDS_HISTOGRAM.size());
+    double packed_secs = time_all_hands([&](int a, int b, int c, int d, int e) {
+        util::poker::card_t cards[] = {
+            packed_deck[a], packed_deck[b], packed_deck[c], packed_deck[d], packed_deck[e]
+        };
+        ++packed[util::poker::category(util::poker::evaluate(cards, 5))];
+    });
+
+    for (std::size_t type = HandTypes::HighCard; type < ALL_HANDS_HISTOGRAM.size(); ++type) {
+        cout << std::left << std::setw(18) << hand_type_to_text[HandTypes(type)] << std::right
+            << std::setw(10) << ALL_HANDS_HISTOGRAM[type]
+            << std::setw(10) << legacy[type] << std::setw(10) << packed[type] << endl;
+    }
+    print_rate("Hand::detect_ranking", legacy_secs);
+    print_rate("util::poker::evaluate", packed_secs);
+    cout << "Speedup: " << std::setprecision(1) << legacy_secs / packed_secs << "x" << endl;
+
+    ASSERT_EQ(legacy, ALL_HANDS_HISTOGRAM);
+    ASSERT_EQ(packed, ALL_HANDS_HISTOGRAM);
+}
+
+TEST(Bench054, BatchFiveCardHands) {
+    const std::size_t num_hands = ALL_HANDS;
+    std::vector<util::poker::card_t> cards(5 * num_hands);
+    std::size_t hand = 0;
+    time_all_hands([&](int a, int b, int c, int d, int e) {
+        int slots[] = {a, b, c, d, e};
+        for (int j = 0; j < 5; ++j) {
+            cards[j * num_hands + hand] = static_cast<util::poker::card_t>(slots[j]);
+        }
+        ++hand;
+    });
+
+    std::vector<util::poker::strength_t> scalar(num_hands), batch(num_hands);
+    auto start = std::chrono::steady_clock::now();
+    util::poker::card_t one[5];
+    for (std::size_t i = 0; i < num_hands; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            one[j] = cards[j * num_hands + i];
+        }
+        scalar[i] = util::poker::evaluate(one, 5);
+    }
+    std::chrono::duration<double> scalar_secs = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    util::poker::evaluate_batch(cards.data(), 5, num_hands, batch.data());
+    std::chrono::duration<double> batch_secs = std::chrono::steady_clock::now() - start;
+
+    print_rate("util::poker::evaluate", scalar_secs.count());
+    print_rate(util::poker::batch_simd() ? "evaluate_batch (AVX2)" : "evaluate_batch (scalar)",
+            batch_secs.count());
+    cout << "Speedup: " << std::setprecision(1) << scalar_secs / batch_secs << "x" << endl;
+    ASSERT_EQ(batch, scalar);
+}
+
+TEST(Bench054, HandLog) {
+    static const std::string BIG_LOG = "/tmp/bench054.log.txt";
+    static const int COPIES = 1000;
+    {
+        std::ifstream input(INPUT);
+        std::stringstream contents;
+        contents << input.rdbuf();
+        std::ofstream fout(BIG_LOG);
+        for (int i = 0; i < COPIES; ++i) {
+            fout << contents.str();
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    int legacy_won = 0;
+    {
+        Hand hand(1), hand2(2);
+        std::ifstream input(BIG_LOG);
+        std::string line;
+        while (std::getline(input, line)) {
+            std::stringstream(line) >> hand >> hand2;
+            hand.detect_ranking();
+            hand2.detect_ranking();
+            legacy_won += hand.beats(hand2);
+        }
+    }
+    std::chrono::duration<double> legacy_secs = std::chrono::steady_clock::now() - start;
+    cout << std::left << std::setw(28) << "istream & Hand" << std::right << std::setw(10)
+        << std::fixed << std::setprecision(3) << legacy_secs.count() << " s" << endl;
+    ASSERT_EQ(legacy_won, 376 * COPIES);
+
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= cores; threads *= 2) {
+        start = std::chrono::steady_clock::now();
+        int won = number_won_hands_parallel(threads, BIG_LOG);
+        std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+        cout << std::left << std::setw(28) << "tally_log, threads " + std::to_string(threads)
+            << std::right << std::setw(10) << secs.count() << " s" << endl;
+        ASSERT_EQ(won, 376 * COPIES);
+    }
+    std::remove(BIG_LOG.c_str());
+}
+
+// Full 169x169 table takes a long while, run with --gtest_also_run_disabled_tests.
+// First run computes & saves it, later runs only map the file.
+TEST(Bench054, DISABLED_PreflopTable) {
+    const std::string CACHE = "./cache.54.private";
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<util::poker::PreflopTable> table = util::poker::PreflopTable::load_or_compute(CACHE);
+    std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+    cout << std::left << std::setw(28) << "load_or_compute" << std::right << std::setw(10)
+        << std::fixed << std::setprecision(3) << secs.count() << " s" << endl;
+
+    start = std::chrono::steady_clock::now();
+    double sum = 0.0;
+    for (int hero = 0; hero < util::poker::NUM_CLASSES; ++hero) {
+        for (int villain = 0; villain < util::poker::NUM_CLASSES; ++villain) {
+            sum += table->equity(hero, villain);
+        }
+    }
+    secs = std::chrono::steady_clock::now() - start;
+    cout << std::left << std::setw(28) << "all lookups" << std::right << std::setw(10)
+        << secs.count() << " s" << endl;
+    // Every cell pairs with its complement.
+    ASSERT_NEAR(sum, util::poker::NUM_CLASSES * util::poker::NUM_CLASSES / 2.0, 0.1);
+    ASSERT_NEAR(table->equity("AA", "KK"), 0.8195, 0.001);
+}
+#endif
@@ -16,9 +16,16 @@ in matrix.txt (right click and "Save Link/Target As..."), a 31K text file contai
 #include <set>
 #include <algorithm>
 #include <numeric>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <stdexcept>
 
 #include "gtest/gtest.h"
 #include "util.hpp"
+#include "matrix_file.hpp"
+#include "parallel.hpp"
+#include "grid_path.hpp"
 
 /**************** Namespace Declarations ******************/
 using std::cout;
@@ -28,193 +35,209 @@ using std::endl;
 static const std::string INPUT = "./src/input_e081.txt";
 static const std::string INPUT_SMALL = "./src/input_e081.small.txt";
 
-class Node;
-class Node {
-public:
-    explicit Node(int value = 0) : value(value) {}
-
-    friend std::ostream & operator<<(std::ostream& os, const Node &node);
-
-    // Data
-    int value = 0;
-    Node *right = NULL;
-    Node *down = NULL;
-};
-typedef std::vector<std::vector<Node> > vec_node_t;
-typedef std::map<const Node*, int> memo_t;
-
-std::ostream & operator<<(std::ostream& os, const Node &node) {
-    int right = 0;
-    int down = 0;
-    if (node.right != NULL) {
-        right = node.right->value;
-    }
-    if (node.down != NULL) {
-        down = node.down->value;
-    }
-    os << "Node: " << node.value << " > " << right << " d " << down;
+typedef util::Matrix<int> matrix_t;
 
-    return os;
-}
+static const int NO_SUM = std::numeric_limits<int>::max();
+static const std::size_t WAVE_TILE = 256;
 
 /*
- * Replace all for a string. Input is csv limited, so convert to space delimited.
+ * Debug only, prints whole matrix.
  */
-std::string replace_all(std::string &original,
-        const std::string &what, const std::string &replacement) {
-    std::size_t pos = std::string::npos;
-    pos = original.find(what);
-    while (pos != std::string::npos) {
-        original.replace(pos, what.length(), replacement);
-        pos = original.find(what, pos);
+void print_matrix(std::ostream &os, const matrix_t &matrix, bool neighbors = false) {
+    for (std::size_t row = 0; row < matrix.rows(); ++row) {
+        for (std::size_t col = 0; col < matrix.cols(); ++col) {
+            os << std::setfill('0') << std::setw(4);
+            if (neighbors) {
+                util::print_cell(os, matrix, matrix.index(row, col), util::MOVES_TWO);
+            } else {
+                os << matrix(row, col);
+            }
+            os << " ";
+        }
+        os << endl;
     }
-
-    return original;
 }
 
 /*
- * Read in the value of a line of nodes.
+ * Minimal sum from index to the bottom right, memo holds the known sums with 0 for unknown.
  */
-void read_line_nodes(const std::string &line, vec_node_t &nodes) {
-    std::stringstream ss(line);
-    std::vector<Node> row;
-    while (ss) {
-        Node node;
-        ss >> node.value;
-        if (node.value) {
-            row.push_back(node);
-        }
+int explore_path(const matrix_t &matrix, std::size_t index, std::vector<int> &memo) {
+    if (memo[index] != 0) {
+        return memo[index];
     }
 
-    nodes.push_back(row);
+    int min_got = 0;
+    matrix.for_neighbors(index, util::MOVES_TWO, [&matrix, &memo, &min_got](std::size_t next) {
+        int temp = explore_path(matrix, next, memo);
+        if (min_got == 0 || temp < min_got) {
+            min_got = temp;
+        }
+    });
+
+    memo[index] = matrix[index] + min_got;
+    return memo[index];
 }
 
 /*
- * Read all nodes from file into nodes.
+ * Minimal sum from the top left to the bottom right, keeping one row of sums.
  */
-void read_all_nodes(const std::string &fname, vec_node_t &nodes) {
-    std::ifstream input(fname, std::ifstream::in);
-    std::string line;
-    while (std::getline(input, line)) {
-        read_line_nodes(replace_all(line, ",", " "), nodes);
-    }
+int min_path_sum(const matrix_t &matrix) {
+    std::vector<int> sums;
+    return util::min_sum_two_way(matrix, sums);
 }
 
 /*
- * Connect all points to the right and down in the nodes.
- * Treat the operation as using index positions.
+ * As min_path_sum but reading the file a row at a time, so only O(cols) is held.
+ * Throws std::runtime_error on ragged rows.
  */
-void connect_nodes(vec_node_t &nodes) {
-    std::size_t row = 0;
-    const std::size_t last_row_ind = nodes.size() - 1;
-    while (row != nodes.size()) {
-        const std::size_t last_col_ind = nodes[row].size() - 1;
-        std::size_t col = 0;
-
-        while (col != nodes[row].size()) {
-            if (col != last_col_ind) {
-                nodes[row][col].right = &nodes[row][col + 1];
-            }
-            if (row < last_row_ind) {
-                nodes[row][col].down = &nodes[row + 1][col];
-            }
-
-            ++col;
+int min_path_sum_stream(const std::string &filename) {
+    util::RowReader reader(filename);
+    std::vector<int> row, sums;
+    while (reader.next(row)) {
+        if (!sums.empty() && row.size() != sums.size()) {
+            throw std::runtime_error("Matrix rows must all be the same length.");
         }
-
-        ++row;
+        util::add_path_row(sums, row.data(), row.size());
     }
+
+    return sums.empty() ? 0 : sums.back();
 }
 
 /*
- * Debug only, prints whole matrix of nodes.
+ * As min_path_sum but cut into tile x tile blocks swept by anti-diagonal.
+ * Block (i, j) only needs the bottom row of (i - 1, j) & the right column of (i, j - 1),
+ * so blocks on one diagonal run in parallel. Those edges live in bottom & right,
+ * O(rows + cols) on top of the matrix, & blocks on a diagonal never share a slice.
  */
-void print_matrix(std::ostream &os, const vec_node_t &nodes, bool pointers = false) {
-    for (auto row : nodes) {
-        for (auto node: row) {
-            os << std::setfill('0') << std::setw(4);
-            if (pointers) {
-                os << node;
-            } else {
-                os << node.value;
-            }
-            os << " ";
-        }
-        os << endl;
+int min_path_sum_wavefront(const matrix_t &matrix, std::size_t tile = WAVE_TILE, unsigned threads = 0) {
+    const std::size_t rows = matrix.rows(), cols = matrix.cols();
+    if (matrix.empty()) {
+        return 0;
     }
-}
-
-int explore_path(const Node &node, memo_t &memo) {
-    if (memo[&node] != 0) {
-        return memo[&node];
-    }
-
-    if (node.right == NULL && node.down == NULL) {
-        return node.value;
-    }
-
-    int min_got = 0;
-    for (Node *next_node : {node.right, node.down}) {
-        if (next_node != NULL) {
-            int temp = explore_path(*next_node, memo);
-            if (min_got == 0 || temp < min_got) {
-                min_got = temp;
+    const std::size_t tile_rows = (rows + tile - 1) / tile, tile_cols = (cols + tile - 1) / tile;
+    std::vector<int> bottom(cols, NO_SUM), right(rows, NO_SUM);
+    std::vector<std::vector<int>> scratch(util::worker_count(threads, std::min(tile_rows, tile_cols)));
+
+    for (std::size_t diagonal = 0; diagonal < tile_rows + tile_cols - 1; ++diagonal) {
+        const std::size_t first = diagonal < tile_cols ? 0 : diagonal - tile_cols + 1;
+        const std::size_t last = std::min(diagonal, tile_rows - 1);
+        util::parallel_for(last - first + 1, threads,
+                [&, diagonal, first](std::size_t task, unsigned worker) {
+            const std::size_t tile_row = first + task, tile_col = diagonal - tile_row;
+            const std::size_t row_start = tile_row * tile, row_end = std::min(rows, row_start + tile);
+            const std::size_t col_start = tile_col * tile, col_end = std::min(cols, col_start + tile);
+            std::vector<int> &above = scratch[worker];
+            above.assign(bottom.begin() + col_start, bottom.begin() + col_end);
+
+            for (std::size_t row = row_start; row < row_end; ++row) {
+                const int *cells = matrix.row(row) + col_start;
+                int left = right[row];
+                for (std::size_t col = 0; col < above.size(); ++col) {
+                    const int best = std::min(above[col], left);
+                    left = above[col] = cells[col] + (best == NO_SUM ? 0 : best);
+                }
+                right[row] = left;
             }
-        }
+            std::copy(above.begin(), above.end(), bottom.begin() + col_start);
+        });
     }
 
-    memo[&node] = node.value + min_got;
-    return memo[&node];
-}
-
-TEST(Euler081, ReplaceAll) {
-    std::string input("4445,2697,5115,718,2209,2212");
-    std::string expect("4445 2697 5115 718 2209 2212");
-    ASSERT_EQ(replace_all(input, ",", " "), expect);
+    return bottom.back();
 }
 
-TEST(Euler081, ReadLineNodes) {
-    vec_node_t nodes;
-    read_line_nodes(std::string("33 22 11"), nodes);
-    ASSERT_EQ(nodes.front().front().value, 33);
-    ASSERT_EQ(nodes.back().back().value, 11);
-}
-
-TEST(Euler081, ReadAllNodes) {
-    vec_node_t nodes;
-    read_all_nodes(std::string(INPUT), nodes);
-    ASSERT_EQ(nodes.front().front().value, 4445);
-    ASSERT_EQ(nodes.back().back().value, 7981);
+TEST(Euler081, ReadMatrix) {
+    matrix_t matrix = util::load_matrix(INPUT);
+    ASSERT_EQ(matrix.rows(), 80);
+    ASSERT_EQ(matrix.cols(), 80);
+    ASSERT_EQ(matrix(0, 0), 4445);
+    ASSERT_EQ(matrix(79, 79), 7981);
 }
 
 TEST(Euler081, PrintMatrix) {
-    vec_node_t nodes;
-    read_all_nodes(std::string(INPUT_SMALL), nodes);
-    connect_nodes(nodes);
+    matrix_t matrix = util::load_matrix(INPUT_SMALL);
     std::stringstream ss;
-    print_matrix(ss, nodes);
+    print_matrix(ss, matrix);
     std::string expect_found = "0131 0673 0234 0103 0018";
     ASSERT_TRUE(ss.str().find(expect_found) != std::string::npos);
 }
 
-TEST(Euler081, ConnectRows) {
-    vec_node_t nodes;
-    read_all_nodes(std::string(INPUT), nodes);
-    connect_nodes(nodes);
+TEST(Euler081, Neighbors) {
+    matrix_t matrix = util::load_matrix(INPUT);
+    std::vector<int> next;
+    matrix.for_neighbors(0, util::MOVES_TWO, [&matrix, &next](std::size_t index) {
+        next.push_back(matrix[index]);
+    });
+    ASSERT_EQ(next, std::vector<int>({2697, 1096}));
+}
+
+TEST(Euler081, MinSumSmall) {
+    matrix_t matrix = util::load_matrix(INPUT_SMALL);
+    ASSERT_EQ(min_path_sum(matrix), 2427);
+    ASSERT_EQ(min_path_sum_stream(INPUT_SMALL), 2427);
+    ASSERT_EQ(min_path_sum_wavefront(matrix, 2, 3), 2427);
+}
 
-    auto first = nodes.front().front();
-    ASSERT_EQ(first.right->value, 2697);
-    ASSERT_EQ(first.down->value, 1096);
+TEST(Euler081, PathSmall) {
+    matrix_t matrix = util::load_matrix(INPUT_SMALL);
+    util::GridPath path = util::astar(matrix, 0, matrix.size() - 1, util::MOVES_TWO);
+    std::vector<int> values;
+    for (std::size_t index : path.cells) {
+        values.push_back(matrix[index]);
+    }
+    ASSERT_EQ(path.sum, 2427);
+    ASSERT_EQ(values, std::vector<int>({131, 201, 96, 342, 746, 422, 121, 37, 331}));
+}
+
+TEST(Euler081, MinSumMatchesRecursion) {
+    std::mt19937 gen(81);
+    std::uniform_int_distribution<int> dist(1, 9999);
+    for (auto shape : {std::make_pair(1, 1), std::make_pair(1, 40), std::make_pair(37, 1),
+            std::make_pair(63, 91)}) {
+        matrix_t matrix(shape.first, shape.second);
+        for (std::size_t index = 0; index < matrix.size(); ++index) {
+            matrix[index] = dist(gen);
+        }
+
+        std::vector<int> memo(matrix.size(), 0);
+        const int expect = explore_path(matrix, 0, memo);
+        ASSERT_EQ(min_path_sum(matrix), expect);
+        for (std::size_t tile : {1, 5, 16, 100}) {
+            ASSERT_EQ(min_path_sum_wavefront(matrix, tile, 4), expect);
+        }
+    }
 }
 
 TEST(Euler081, MinSumTwoWays) {
-    vec_node_t nodes;
-    read_all_nodes(std::string(INPUT), nodes);
-    connect_nodes(nodes);
-    const Node &root = nodes.front().front();
-    memo_t memo;
-    int min_sum = explore_path(root, memo);
+    matrix_t matrix = util::load_matrix(INPUT);
+    std::vector<int> memo(matrix.size(), 0);
+    ASSERT_EQ(explore_path(matrix, 0, memo), 427337);
+    ASSERT_EQ(min_path_sum(matrix), 427337);
+    ASSERT_EQ(min_path_sum_wavefront(matrix, 16), 427337);
 
+    int min_sum = min_path_sum_stream(INPUT);
     ASSERT_EQ(min_sum, 427337);
     cout << "The sum of the path taken is " << min_sum << endl;
 }
+
+#ifdef BENCH
+////////////
+// Benchmarks, only built into Bench081.exe
+////////////
+TEST(Bench081, MinSumWavefront) {
+    matrix_t matrix(3000, 2500);
+    std::mt19937 gen(4);
+    std::uniform_int_distribution<int> dist(1, 9999);
+    for (std::size_t index = 0; index < matrix.size(); ++index) {
+        matrix[index] = dist(gen);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const int expect = min_path_sum(matrix);
+    auto mid = std::chrono::steady_clock::now();
+    ASSERT_EQ(min_path_sum_wavefront(matrix), expect);
+    auto stop = std::chrono::steady_clock::now();
+    cout << "Row DP " << std::chrono::duration<double, std::milli>(mid - start).count()
+        << "ms, wavefront " << std::chrono::duration<double, std::milli>(stop - mid).count()
+        << "ms on " << util::worker_count(0, matrix.cols() / WAVE_TILE) << " threads" << endl;
+}
+#endif
@@ -17,9 +17,14 @@ in matrix.txt (right click and "Save Link/Target As..."), a 31K text file contai
 #include <algorithm>
 #include <numeric>
 #include <climits>
+#include <chrono>
+#include <random>
 
 #include "gtest/gtest.h"
 #include "util.hpp"
+#include "matrix_file.hpp"
+#include "grid_path.hpp"
+#include "parallel.hpp"
 
 /**************** Namespace Declarations ******************/
 using std::cout;
@@ -29,123 +34,19 @@ using std::endl;
 static const std::string INPUT = "./src/input_e081.txt";
 static const std::string INPUT_SMALL = "./src/input_e081.small.txt";
 
-class Node;
-class Node {
-public:
-    explicit Node(int value = 0) : value(value) {}
-
-    friend std::ostream & operator<<(std::ostream& os, const Node &node);
-
-    // Data
-    int value = 0;
-    Node *up = NULL;
-    Node *right = NULL;
-    Node *down = NULL;
-};
-typedef std::vector<std::vector<Node> > vec_node_t;
-typedef std::map<const Node*, int> memo_t;
-
-std::ostream & operator<<(std::ostream& os, const Node &node) {
-    int right = 0;
-    int down = 0;
-    int up = 0;
-    if (node.up != NULL) {
-        up = node.up->value;
-    }
-    if (node.right != NULL) {
-        right = node.right->value;
-    }
-    if (node.down != NULL) {
-        down = node.down->value;
-    }
-    os << "Node: " << node.value << "(" << up << ", " << right << ", " << down << ")";
-
-    return os;
-}
-
-/*
- * Replace all for a string. Input is csv limited, so convert to space delimited.
- */
-std::string replace_all(std::string &original,
-        const std::string &what, const std::string &replacement) {
-    std::size_t pos = std::string::npos;
-    pos = original.find(what);
-    while (pos != std::string::npos) {
-        original.replace(pos, what.length(), replacement);
-        pos = original.find(what, pos);
-    }
-
-    return original;
-}
-
-/*
- * Read in the value of a line of nodes.
- */
-void read_line_nodes(const std::string &line, vec_node_t &nodes) {
-    std::stringstream ss(line);
-    std::vector<Node> row;
-    while (ss) {
-        Node node;
-        ss >> node.value;
-        if (node.value) {
-            row.push_back(node);
-        }
-    }
-
-    nodes.push_back(row);
-}
-
-/*
- * Read all nodes from file into nodes.
- */
-void read_all_nodes(const std::string &fname, vec_node_t &nodes) {
-    std::ifstream input(fname, std::ifstream::in);
-    std::string line;
-    while (std::getline(input, line)) {
-        read_line_nodes(replace_all(line, ",", " "), nodes);
-    }
-}
-
-/*
- * Connect all points to the right and down in the nodes.
- * Treat the operation as using index positions.
- */
-void connect_nodes(vec_node_t &nodes) {
-    std::size_t row = 0;
-    const std::size_t last_row_ind = nodes.size() - 1;
-    while (row != nodes.size()) {
-        const std::size_t last_col_ind = nodes[row].size() - 1;
-        std::size_t col = 0;
-
-        while (col != nodes[row].size()) {
-            if (col != last_col_ind) {
-                nodes[row][col].right = &nodes[row][col + 1];
-            }
-            if (row < last_row_ind) {
-                nodes[row][col].down = &nodes[row + 1][col];
-            }
-            if ((row) >= 1) {
-                nodes[row][col].up = &nodes[row - 1][col];
-            }
-
-            ++col;
-        }
-
-        ++row;
-    }
-}
+typedef util::Matrix<int> matrix_t;
 
 /*
- * Debug only, prints whole matrix of nodes.
+ * Debug only, prints whole matrix.
  */
-void print_matrix(std::ostream &os, const vec_node_t &nodes, bool pointers = false) {
-    for (auto row : nodes) {
-        for (auto node: row) {
+void print_matrix(std::ostream &os, const matrix_t &matrix, bool neighbors = false) {
+    for (std::size_t row = 0; row < matrix.rows(); ++row) {
+        for (std::size_t col = 0; col < matrix.cols(); ++col) {
             os << std::setfill('0') << std::setw(4);
-            if (pointers) {
-                os << node;
+            if (neighbors) {
+                util::print_cell(os, matrix, matrix.index(row, col), util::MOVES_THREE);
             } else {
-                os << node.value;
+                os << matrix(row, col);
             }
             os << " ";
         }
@@ -155,90 +56,152 @@ void print_matrix(std::ostream &os, const vec_node_t &nodes, bool pointers = fal
 
 // TODO: Improvements
 //  - Optional: I'd like to track nodes taken on solution.
-void explore_path(Node &node, int sum_so_far, memo_t &memo) {
+void explore_path(const matrix_t &matrix, std::size_t index, int sum_so_far, std::vector<int> &memo) {
     // Always record the cost to get to current node.
     // If the cost to get to current is HIGHER than recorded, abort route.
-    const int current_sum = sum_so_far + node.value;
-    if (!memo[&node]) {
-        memo[&node] = current_sum;
+    const int current_sum = sum_so_far + matrix[index];
+    if (!memo[index]) {
+        memo[index] = current_sum;
     } else {
-        if (current_sum < memo[&node]) {
-            memo[&node] = current_sum;
+        if (current_sum < memo[index]) {
+            memo[index] = current_sum;
         } else {
             return;
         }
     }
 
     // Stop condition, reached right, we are at a solution.
-    if (node.right == NULL) {
+    if (matrix.col_of(index) + 1 == matrix.cols()) {
         return;
     }
 
-    for (Node * next_node : {node.up, node.right, node.down}) {
-        if (next_node != NULL) {
-            explore_path(*next_node, current_sum, memo);
-        }
-    }
-}
-
-TEST(Euler081, ReplaceAll) {
-    std::string input("4445,2697,5115,718,2209,2212");
-    std::string expect("4445 2697 5115 718 2209 2212");
-    ASSERT_EQ(replace_all(input, ",", " "), expect);
+    matrix.for_neighbors(index, util::MOVES_THREE, [&matrix, current_sum, &memo](std::size_t next) {
+        explore_path(matrix, next, current_sum, memo);
+    });
 }
 
-TEST(Euler081, ReadLineNodes) {
-    vec_node_t nodes;
-    read_line_nodes(std::string("33 22 11"), nodes);
-    ASSERT_EQ(nodes.front().front().value, 33);
-    ASSERT_EQ(nodes.back().back().value, 11);
+/*
+ * Minimal sum from any cell of the left column to any of the right, moving up, right & down.
+ * Tall matrices scan each column in blocks on threads workers (0 for all cores).
+ */
+int min_path_sum(const matrix_t &matrix, unsigned threads = 0) {
+    std::vector<int> sums;
+    matrix_t columns;
+    return util::min_sum_three_way(matrix, sums, columns, threads);
 }
 
-TEST(Euler081, ReadAllNodes) {
-    vec_node_t nodes;
-    read_all_nodes(std::string(INPUT), nodes);
-    ASSERT_EQ(nodes.front().front().value, 4445);
-    ASSERT_EQ(nodes.back().back().value, 7981);
+TEST(Euler081, ReadMatrix) {
+    matrix_t matrix = util::load_matrix(INPUT);
+    ASSERT_EQ(matrix(0, 0), 4445);
+    ASSERT_EQ(matrix(79, 79), 7981);
 }
 
-TEST(Euler081, ConnectRows) {
-    vec_node_t nodes;
-    read_all_nodes(std::string(INPUT), nodes);
-    connect_nodes(nodes);
-
-    auto first = nodes[1].front();
-    ASSERT_EQ(first.up->value, 4445);
-    ASSERT_EQ(first.right->value, 20);
-    ASSERT_EQ(first.down->value, 9607);
+TEST(Euler081, Neighbors) {
+    matrix_t matrix = util::load_matrix(INPUT);
+    std::vector<int> next;
+    matrix.for_neighbors(matrix.index(1, 0), util::MOVES_THREE, [&matrix, &next](std::size_t index) {
+        next.push_back(matrix[index]);
+    });
+    ASSERT_EQ(next, std::vector<int>({4445, 20, 9607}));
 }
 
 TEST(Euler081, PrintMatrix) {
-    vec_node_t nodes;
-    read_all_nodes(std::string(INPUT_SMALL), nodes);
-    connect_nodes(nodes);
+    matrix_t matrix = util::load_matrix(INPUT_SMALL);
     std::stringstream ss;
-    print_matrix(ss, nodes, true);
+    print_matrix(ss, matrix, true);
     std::string expect_found = "Node: 131(0, 673, 201) Node: 673(0, 234, 96) Node: 234(0, 103, 342) Node: 103(0, 18, 965) Node: 18(0, 0, 150)";
     ASSERT_TRUE(ss.str().find(expect_found) != std::string::npos);
 }
 
+TEST(Euler081, Transpose) {
+    matrix_t matrix(2, 3, std::vector<int>({1, 2, 3, 4, 5, 6}));
+    matrix_t flipped(5, 5, 0);
+    util::transpose(matrix, flipped);
+    ASSERT_EQ(flipped.rows(), 3);
+    ASSERT_EQ(flipped.cols(), 2);
+    ASSERT_EQ(flipped(2, 1), 6);
+    ASSERT_EQ(flipped(1, 0), 2);
+}
+
+TEST(Euler081, MinSumSmall) {
+    ASSERT_EQ(min_path_sum(util::load_matrix(INPUT_SMALL)), 994);
+}
+
+TEST(Euler081, MinSumMatchesRecursion) {
+    std::mt19937 gen(82);
+    std::uniform_int_distribution<int> dist(1, 9999);
+    for (auto shape : {std::make_pair(1, 1), std::make_pair(1, 30), std::make_pair(25, 1),
+            std::make_pair(17, 23), std::make_pair(70, 65)}) {
+        matrix_t matrix(shape.first, shape.second);
+        for (std::size_t index = 0; index < matrix.size(); ++index) {
+            matrix[index] = dist(gen);
+        }
+
+        std::vector<int> memo(matrix.size(), 0);
+        for (std::size_t row = 0; row < matrix.rows(); ++row) {
+            explore_path(matrix, matrix.index(row, 0), 0, memo);
+        }
+        int expect = INT_MAX;
+        for (std::size_t row = 0; row < matrix.rows(); ++row) {
+            expect = std::min(expect, memo[matrix.index(row, matrix.cols() - 1)]);
+        }
+        ASSERT_EQ(min_path_sum(matrix), expect);
+    }
+}
+
 TEST(Euler081, MinSumTwoWays) {
-    vec_node_t nodes;
-    read_all_nodes(std::string(INPUT), nodes);
-    connect_nodes(nodes);
-
-    memo_t memo;
-    for (std::vector<Node> &row : nodes) {
-        Node &root = row.front();
-        explore_path(root, 0, memo);
+    matrix_t matrix = util::load_matrix(INPUT);
+
+    std::vector<int> memo(matrix.size(), 0);
+    for (std::size_t row = 0; row < matrix.rows(); ++row) {
+        explore_path(matrix, matrix.index(row, 0), 0, memo);
     }
     int best = 0;
-    for (std::vector<Node> &row : nodes) {
-        if (best == 0 || memo[&row.back()] < best) {
-            best = memo[&row.back()];
+    for (std::size_t row = 0; row < matrix.rows(); ++row) {
+        int sum = memo[matrix.index(row, matrix.cols() - 1)];
+        if (best == 0 || sum < best) {
+            best = sum;
         }
     }
 
-    cout << "The best sum path is " << best << endl;
     ASSERT_EQ(best, 260324);
+    ASSERT_EQ(min_path_sum(matrix), 260324);
+    cout << "The best sum path is " << best << endl;
+}
+
+#ifdef BENCH
+////////////
+// Benchmarks, only built into Bench082.exe
+////////////
+/*
+ * Reference sum by dijkstra, matrix padded with a zero column either side so
+ * one search from the top left covers every start & end row.
+ */
+int padded_dijkstra(const matrix_t &matrix) {
+    matrix_t padded(matrix.rows(), matrix.cols() + 2, 0);
+    for (std::size_t row = 0; row < matrix.rows(); ++row) {
+        std::copy(matrix.row(row), matrix.row(row) + matrix.cols(), padded.row(row) + 1);
+    }
+
+    return util::dijkstra(padded, 0, util::MOVES_THREE).back();
+}
+
+TEST(Bench082, MinSumLarge) {
+    matrix_t matrix(20000, 400);
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<int> dist(1, 9999);
+    for (std::size_t index = 0; index < matrix.size(); ++index) {
+        matrix[index] = dist(gen);
+    }
+
+    const int expect = padded_dijkstra(matrix);
+    for (unsigned threads : {1, 4}) {
+        auto start = std::chrono::steady_clock::now();
+        ASSERT_EQ(min_path_sum(matrix, threads), expect);
+        auto stop = std::chrono::steady_clock::now();
+        cout << "Column sweep over " << matrix.rows() << "x" << matrix.cols() << " on "
+            << util::worker_count(threads, matrix.rows() / util::SCAN_BLOCK) << " threads took "
+            << std::chrono::duration<double, std::milli>(stop - start).count() << "ms" << endl;
+    }
 }
+#endif
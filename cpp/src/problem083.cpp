@@ -18,9 +18,16 @@ in matrix.txt (right click and "Save Link/Target As..."), a 31K text file contai
 #include <algorithm>
 #include <numeric>
 #include <climits>
+#include <cstdio>
+#include <chrono>
+#include <random>
 
 #include "gtest/gtest.h"
 #include "util.hpp"
+#include "matrix_file.hpp"
+#include "grid_path.hpp"
+#include "parallel.hpp"
+#include "path_batch.hpp"
 
 /**************** Namespace Declarations ******************/
 using std::cout;
@@ -30,134 +37,19 @@ using std::endl;
 static const std::string INPUT = "./src/input_e081.txt";
 static const std::string INPUT_SMALL = "./src/input_e081.small.txt";
 
-class Node;
-class Node {
-public:
-    explicit Node(int value = 0) : value(value) {}
-
-    friend std::ostream & operator<<(std::ostream& os, const Node &node);
-
-    // Data
-    int value = 0;
-    int sum_value = 0;
-    bool visited = false;
-    bool selected = false;
-    Node *up = NULL;
-    Node *right = NULL;
-    Node *down = NULL;
-    Node *left = NULL;
-};
-typedef std::vector<std::vector<Node> > vec_node_t;
-typedef std::map<const Node*, int> memo_t;
-
-std::ostream & operator<<(std::ostream& os, const Node &node) {
-    int up = 0;
-    int right = 0;
-    int down = 0;
-    int left = 0;
-    if (node.up != NULL) {
-        up = node.up->value;
-    }
-    if (node.right != NULL) {
-        right = node.right->value;
-    }
-    if (node.down != NULL) {
-        down = node.down->value;
-    }
-    if (node.left != NULL) {
-        left = node.left->value;
-    }
-    os << "Node: " << node.value << "(" << up << ", " << right << ", " << down << ", " << left << ")";
-
-    return os;
-}
-
-/*
- * Replace all for a string. Input is csv limited, so convert to space delimited.
- */
-std::string replace_all(std::string &original,
-        const std::string &what, const std::string &replacement) {
-    std::size_t pos = std::string::npos;
-    pos = original.find(what);
-    while (pos != std::string::npos) {
-        original.replace(pos, what.length(), replacement);
-        pos = original.find(what, pos);
-    }
-
-    return original;
-}
-
-/*
- * Read in the value of a line of nodes.
- */
-void read_line_nodes(const std::string &line, vec_node_t &nodes) {
-    std::stringstream ss(line);
-    std::vector<Node> row;
-    while (ss) {
-        Node node;
-        ss >> node.value;
-        if (node.value) {
-            row.push_back(node);
-        }
-    }
-
-    nodes.push_back(row);
-}
-
-/*
- * Read all nodes from file into nodes.
- */
-void read_all_nodes(const std::string &fname, vec_node_t &nodes) {
-    std::ifstream input(fname, std::ifstream::in);
-    std::string line;
-    while (std::getline(input, line)) {
-        read_line_nodes(replace_all(line, ",", " "), nodes);
-    }
-}
+typedef util::Matrix<int> matrix_t;
 
 /*
- * Connect all points to the right and down in the nodes.
- * Treat the operation as using index positions.
+ * Debug only, prints whole matrix.
  */
-void connect_nodes(vec_node_t &nodes) {
-    std::size_t row = 0;
-    const std::size_t last_row_ind = nodes.size() - 1;
-    while (row != nodes.size()) {
-        const std::size_t last_col_ind = nodes[row].size() - 1;
-        std::size_t col = 0;
-
-        while (col != nodes[row].size()) {
-            if (col < last_col_ind) {
-                nodes[row][col].right = &nodes[row][col + 1];
-            }
-            if (row < last_row_ind) {
-                nodes[row][col].down = &nodes[row + 1][col];
-            }
-            if (row >= 1) {
-                nodes[row][col].up = &nodes[row - 1][col];
-            }
-            if (col >= 1) {
-                nodes[row][col].left = &nodes[row][col - 1];
-            }
-
-            ++col;
-        }
-
-        ++row;
-    }
-}
-
-/*
- * Debug only, prints whole matrix of nodes.
- */
-void print_matrix(std::ostream &os, const vec_node_t &nodes, bool pointers = false) {
-    for (auto row : nodes) {
-        for (auto node: row) {
+void print_matrix(std::ostream &os, const matrix_t &matrix, bool neighbors = false) {
+    for (std::size_t row = 0; row < matrix.rows(); ++row) {
+        for (std::size_t col = 0; col < matrix.cols(); ++col) {
             os << std::setfill('0') << std::setw(4);
-            if (pointers) {
-                os << node;
+            if (neighbors) {
+                util::print_cell(os, matrix, matrix.index(row, col), util::MOVES_FOUR);
             } else {
-                os << node.value;
+                os << matrix(row, col);
             }
             os << " ";
         }
@@ -166,148 +58,273 @@ void print_matrix(std::ostream &os, const vec_node_t &nodes, bool pointers = fal
 }
 
 // N.B. This is a slow implementation modified quickly from previous, see explore_path2 for almost linear solution.
-void explore_path(Node &node, int sum_so_far, memo_t &memo) {
+void explore_path(const matrix_t &matrix, std::size_t index, int sum_so_far, std::vector<int> &memo,
+        std::vector<char> &visited) {
     // Always record the cost to get to current node.
     // If the cost to get to current is HIGHER than recorded, abort route.
-    const int current_sum = sum_so_far + node.value;
-    if (!memo[&node]) {
-        memo[&node] = current_sum;
+    const int current_sum = sum_so_far + matrix[index];
+    if (!memo[index]) {
+        memo[index] = current_sum;
     } else {
-        if (current_sum < memo[&node]) {
-            memo[&node] = current_sum;
+        if (current_sum < memo[index]) {
+            memo[index] = current_sum;
         } else {
             return;
         }
     }
 
-    // Stop condition, reached right, we are at a solution.
-    if (node.right == NULL && node.down == NULL) {
+    // Stop condition, reached bottom right, we are at a solution.
+    if (index + 1 == matrix.size()) {
         return;
     }
 
-    node.visited = true;
-    for (Node * next_node : {node.up, node.right, node.down, node.left}) {
-        if (next_node != NULL && next_node->visited == false) {
-            explore_path(*next_node, current_sum, memo);
+    visited[index] = true;
+    matrix.for_neighbors(index, util::MOVES_FOUR,
+            [&matrix, current_sum, &memo, &visited](std::size_t next) {
+        if (!visited[next]) {
+            explore_path(matrix, next, current_sum, memo, visited);
         }
-    }
-    node.visited = false;
+    });
+    visited[index] = false;
 }
 
-// Push BACK new values IF they are less than existing sum_value.
-// Keep recursing until there is no improvement in sum_value
-void recurse_push(Node *node, Node *origin) {
-    for (Node *next_node : {node->up, node->right, node->down, node->left}) {
-        if (next_node == NULL || next_node == origin) {
-            continue;
+// Push BACK new values IF they are less than existing sums.
+// Keep recursing until there is no improvement in sums.
+void recurse_push(const matrix_t &matrix, std::vector<int> &sums, std::size_t index, std::size_t origin) {
+    matrix.for_neighbors(index, util::MOVES_FOUR, [&matrix, &sums, index, origin](std::size_t next) {
+        if (next == origin) {
+            return;
         }
-        int new_sum = next_node->value + node->sum_value;
-        if (next_node->sum_value > new_sum) {
-            next_node->sum_value = new_sum;
-            recurse_push(next_node, node);
+        int new_sum = matrix[next] + sums[index];
+        if (sums[next] > new_sum) {
+            sums[next] = new_sum;
+            recurse_push(matrix, sums, next, index);
         }
-    }
+    });
 }
 
-void explore_path2(Node &root) {
-    std::deque<Node *> todo;
-    root.selected = true;
-    root.sum_value = root.value;
-    todo.push_back(&root);
-    Node *node;
+/*
+ * Minimal sum from root to every cell, 0 for cells never reached.
+ */
+std::vector<int> explore_path2(const matrix_t &matrix, std::size_t root = 0) {
+    std::vector<int> sums(matrix.size(), 0);
+    std::vector<char> selected(matrix.size(), false);
+    std::deque<std::size_t> todo;
+    selected[root] = true;
+    sums[root] = matrix[root];
+    todo.push_back(root);
 
     while (!todo.empty()) {
-        node = todo.front();
+        std::size_t index = todo.front();
         todo.pop_front();
 
-        for (Node *next_node : {node->up, node->right, node->down, node->left}) {
-            if (next_node == NULL) {
-                continue;
-            }
-
-            int sum_to_next = node->sum_value + next_node->value;
-            if (next_node->sum_value == 0) {
-                next_node->sum_value = sum_to_next;
-            } else if (next_node->sum_value > sum_to_next) {
-                next_node->sum_value = sum_to_next;
-                recurse_push(next_node, node);
+        matrix.for_neighbors(index, util::MOVES_FOUR,
+                [&matrix, &sums, &selected, &todo, index](std::size_t next) {
+            int sum_to_next = sums[index] + matrix[next];
+            if (sums[next] == 0) {
+                sums[next] = sum_to_next;
+            } else if (sums[next] > sum_to_next) {
+                sums[next] = sum_to_next;
+                recurse_push(matrix, sums, next, index);
             }
 
-            if (!next_node->selected) {
-                next_node->selected = true;
-                todo.push_back(next_node);
+            if (!selected[next]) {
+                selected[next] = true;
+                todo.push_back(next);
             }
-        }
+        });
     }
-}
 
-
-TEST(Euler081, ReplaceAll) {
-    std::string input("4445,2697,5115,718,2209,2212");
-    std::string expect("4445 2697 5115 718 2209 2212");
-    ASSERT_EQ(replace_all(input, ",", " "), expect);
+    return sums;
 }
 
-TEST(Euler081, ReadLineNodes) {
-    vec_node_t nodes;
-    read_line_nodes(std::string("33 22 11"), nodes);
-    ASSERT_EQ(nodes.front().front().value, 33);
-    ASSERT_EQ(nodes.back().back().value, 11);
-}
 
-TEST(Euler081, ReadAllNodes) {
-    vec_node_t nodes;
-    read_all_nodes(std::string(INPUT), nodes);
-    ASSERT_EQ(nodes.front().front().value, 4445);
-    ASSERT_EQ(nodes.back().back().value, 7981);
+TEST(Euler081, ReadMatrix) {
+    matrix_t matrix = util::load_matrix(INPUT);
+    ASSERT_EQ(matrix(0, 0), 4445);
+    ASSERT_EQ(matrix(79, 79), 7981);
 }
 
-TEST(Euler081, ConnectRows) {
-    vec_node_t nodes;
-    read_all_nodes(std::string(INPUT), nodes);
-    connect_nodes(nodes);
-
-    auto node = nodes[1].at(1);
-    ASSERT_EQ(node.up->value, 2697);
-    ASSERT_EQ(node.right->value, 1318);
-    ASSERT_EQ(node.down->value, 7385);
-    ASSERT_EQ(node.left->value, 1096);
+TEST(Euler081, Neighbors) {
+    matrix_t matrix = util::load_matrix(INPUT);
+    std::vector<int> next;
+    matrix.for_neighbors(matrix.index(1, 1), util::MOVES_FOUR, [&matrix, &next](std::size_t index) {
+        next.push_back(matrix[index]);
+    });
+    ASSERT_EQ(next, std::vector<int>({2697, 1318, 7385, 1096}));
 }
 
 TEST(Euler081, PrintMatrix) {
-    vec_node_t nodes;
-    read_all_nodes(std::string(INPUT_SMALL), nodes);
-    connect_nodes(nodes);
+    matrix_t matrix = util::load_matrix(INPUT_SMALL);
     std::stringstream ss;
-    print_matrix(ss, nodes, true);
+    print_matrix(ss, matrix, true);
     std::string expected_found = "Node: 201(131, 96, 630, 0) Node: 96(673, 342, 803, 201) Node: 342(234, 965, 746, 96) Node: 965(103, 150, 422, 342) Node: 150(18, 0, 111, 965)";
     ASSERT_TRUE(ss.str().find(expected_found) != std::string::npos);
 }
 
+TEST(Euler081, DijkstraSmall) {
+    matrix_t matrix = util::load_matrix(INPUT_SMALL);
+    ASSERT_EQ(util::dijkstra(matrix).back(), 2297);
+    ASSERT_EQ(util::dijkstra(matrix), explore_path2(matrix));
+}
+
+TEST(Euler081, DijkstraMatchesExplore) {
+    matrix_t matrix = util::load_matrix(INPUT);
+    for (std::size_t root : {std::size_t(0), matrix.index(40, 17), matrix.size() - 1}) {
+        ASSERT_EQ(util::dijkstra(matrix, root), explore_path2(matrix, root));
+    }
+}
+
+TEST(Euler081, PathSmall) {
+    matrix_t matrix = util::load_matrix(INPUT_SMALL);
+    const std::vector<int> expect({131, 201, 96, 342, 234, 103, 18, 150, 111, 422, 121, 37, 331});
+    for (const util::GridPath &path : {util::astar(matrix, 0, matrix.size() - 1),
+            util::bidirectional(matrix, 0, matrix.size() - 1)}) {
+        std::vector<int> values;
+        for (std::size_t index : path.cells) {
+            values.push_back(matrix[index]);
+        }
+        ASSERT_EQ(path.sum, 2297);
+        ASSERT_EQ(values, expect);
+    }
+}
+
 TEST(Euler081, MinSumFourWays) {
-    vec_node_t nodes;
-    read_all_nodes(std::string(INPUT), nodes);
-    connect_nodes(nodes);
+    matrix_t matrix = util::load_matrix(INPUT);
+    std::vector<int> sums = util::dijkstra(matrix);
+
+    cout << "Best path to node: " << matrix[matrix.size() - 1] << " is " << sums.back() << endl;
+    ASSERT_EQ(sums.back(), 425185);
+    ASSERT_EQ(util::astar(matrix, 0, matrix.size() - 1).sum, 425185);
+    ASSERT_EQ(util::bidirectional(matrix, 0, matrix.size() - 1).sum, 425185);
+}
+
+TEST(Euler081, MinSumAfterUpdate) {
+    matrix_t matrix = util::load_matrix(INPUT);
+    util::DynamicGridPath dynamic(matrix);
+    ASSERT_EQ(dynamic.sum(matrix.size() - 1), 425185);
 
-    Node &root = nodes.front().front();
-    explore_path2(root);
+    // Make the middle of the best path expensive, the repaired sums must match a fresh solve.
+    std::vector<std::size_t> cells = dynamic.path(matrix.size() - 1);
+    dynamic.set_weight(cells[cells.size() / 2], 50000);
+    ASSERT_EQ(dynamic.sums(), util::dijkstra(dynamic.weights()));
+    ASSERT_GT(dynamic.sum(matrix.size() - 1), 425185);
 
-    Node &end = nodes.back().back();
-    cout << "Best path to node: " << end.value << " is " << end.sum_value << endl;
-    ASSERT_EQ(end.sum_value, 425185);
+    dynamic.set_weight(cells[cells.size() / 2], matrix[cells[cells.size() / 2]]);
+    ASSERT_EQ(dynamic.sum(matrix.size() - 1), 425185);
+}
+
+TEST(Euler081, BatchModels) {
+    ASSERT_EQ(util::solve_batch(INPUT, util::movement_model(2)), std::vector<int>({427337}));
+    ASSERT_EQ(util::solve_batch(INPUT, util::movement_model(3)), std::vector<int>({260324}));
+    ASSERT_EQ(util::solve_batch(INPUT, util::movement_model(4)), std::vector<int>({425185}));
 }
 
 // Naieve implementation left
 // TEST(Euler081, MinSumFourWays) {
-    // vec_node_t nodes;
-    // read_all_nodes(std::string(INPUT), nodes);
-    // connect_nodes(nodes);
+    // matrix_t matrix = util::load_matrix(INPUT);
 
-    // memo_t memo;
-    // Node &root = nodes.front().front();
-    // explore_path(root, 0, memo);
+    // std::vector<int> memo(matrix.size(), 0);
+    // std::vector<char> visited(matrix.size(), false);
+    // explore_path(matrix, 0, 0, memo, visited);
 
-    // Node &end = nodes.back().back();
-    // cout << "Best path to node: " << end.value << " is " << memo[&end] << endl;
-    // ASSERT_EQ(memo[&end], 425185);
+    // cout << "Best path to node: " << matrix[matrix.size() - 1] << " is " << memo.back() << endl;
+    // ASSERT_EQ(memo.back(), 425185);
 // }
+
+#ifdef BENCH
+////////////
+// Benchmarks, only built into Bench083.exe
+////////////
+matrix_t random_matrix(std::size_t rows, std::size_t cols, int max_weight, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(1, max_weight);
+    matrix_t matrix(rows, cols);
+    for (std::size_t index = 0; index < matrix.size(); ++index) {
+        matrix[index] = dist(gen);
+    }
+
+    return matrix;
+}
+
+double millis_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+TEST(Bench083, Dijkstra) {
+    matrix_t matrix = random_matrix(1000, 1000, 9999, 47);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<int> sums = util::dijkstra(matrix);
+    ASSERT_NE(sums.back(), util::NO_PATH);
+    cout << "Dijkstra over " << matrix.size() << " cells took " << millis_since(start) << "ms" << endl;
+}
+
+TEST(Bench083, DeltaSteppingScaling) {
+    matrix_t matrix = random_matrix(1500, 1500, 9999, 48);
+    const std::vector<int> expect = util::dijkstra(matrix);
+    const unsigned cores = util::worker_count(0, matrix.size());
+    for (unsigned threads = 1; threads <= cores * 2; threads *= 2) {
+        auto start = std::chrono::steady_clock::now();
+        ASSERT_EQ(util::delta_stepping(matrix, 0, util::MOVES_FOUR, 0, threads), expect);
+        cout << "Delta stepping over " << matrix.size() << " cells on " << threads << " threads took "
+            << millis_since(start) << "ms" << endl;
+    }
+}
+
+TEST(Bench083, PointToPoint) {
+    matrix_t matrix = random_matrix(1000, 1000, 10, 49);
+    const std::size_t source = matrix.index(400, 400), target = matrix.index(450, 470);
+
+    auto start = std::chrono::steady_clock::now();
+    util::GridPath forward = util::astar(matrix, source, target);
+    const double forward_ms = millis_since(start);
+    start = std::chrono::steady_clock::now();
+    util::GridPath both = util::bidirectional(matrix, source, target);
+    const double both_ms = millis_since(start);
+    ASSERT_EQ(forward.sum, both.sum);
+    cout << "Settled of " << matrix.size() << " cells, A* " << forward.settled << " in " << forward_ms
+        << "ms, bidirectional " << both.settled << " in " << both_ms << "ms" << endl;
+}
+
+TEST(Bench083, DynamicRepair) {
+    matrix_t matrix = random_matrix(1000, 1000, 9999, 50);
+    auto start = std::chrono::steady_clock::now();
+    util::DynamicGridPath dynamic(matrix);
+    const double solve = millis_since(start);
+
+    const std::size_t index = matrix.index(990, 985);
+    start = std::chrono::steady_clock::now();
+    dynamic.set_weight(index, matrix[index] + 5000);
+    const std::size_t raised = dynamic.last_settled();
+    dynamic.set_weight(index, 0);
+    const double updates = millis_since(start);
+    ASSERT_EQ(dynamic.sum(matrix.size() - 1), util::dijkstra(dynamic.weights()).back());
+    cout << "Full solve " << solve << "ms, two updates " << updates << "ms settling "
+        << raised << " & " << dynamic.last_settled() << " cells" << endl;
+}
+
+TEST(Bench083, BatchThroughput) {
+    static const std::string fname = "/tmp/bench083_batch.txt";
+    static const int count = 1000, side = 40;
+    {
+        std::ofstream fout(fname);
+        for (int index = 0; index < count; ++index) {
+            matrix_t matrix = random_matrix(side, side, 9999, 51 + index);
+            for (std::size_t cell = 0; cell < matrix.size(); ++cell) {
+                fout << matrix[cell] << (matrix.col_of(cell) + 1 == matrix.cols() ? "\n" : ",");
+            }
+            fout << "\n";
+        }
+    }
+
+    for (int ways : {2, 3, 4}) {
+        util::BatchStats stats;
+        std::vector<int> sums = util::solve_batch(fname, util::movement_model(ways), 0, &stats);
+        ASSERT_EQ(sums.size(), count);
+        ASSERT_EQ(stats.cells, count * side * side);
+        cout << ways << " way batch of " << stats.matrices << " " << side << "x" << side
+            << " matrices, " << stats.per_second() << " matrices/sec" << endl;
+    }
+    std::remove(fname.c_str());
+}
+#endif
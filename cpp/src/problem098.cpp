@@ -18,17 +18,20 @@ This problem requires a multistage solution.
 1.5) Map all anagrams to a group with same HASH first, that is, all the words are anagrams.
      Next map all anagrams to a PATTERN, the pattern may differ by anagram depending on arrangement.
 2) Identify the maximum length of a word in the file, LEN_MAX.
-3) Compute all square numbers that contain digits <= LEN_MAX.
-4) Group the above square numbers into a hash_map by PATTERN.
+3) Collect the PATTERN of every word in an anagram group.
+4) Compute only the square numbers with those patterns, grouped by PATTERN.
+   Each digit length is scanned once however many patterns want it.
 5) To find the largest number, iterate over all groupings of words and attempt to
    create square anagram pairs by starting with first word and a known square number that fits.
  */
 /********************* Header Files ***********************/
 /* C++ Headers */
 #include <iostream> /* Input/output objects. */
+#include <chrono>
 #include <fstream>
 #include <sstream>
 #include <exception>
+#include <stdexcept>
 #include <initializer_list>
 #include <map>
 #include <set>
@@ -37,43 +40,59 @@ This problem requires a multistage solution.
 #include <string>
 #include <numeric>
 #include <functional>
+#include <limits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
 
 #include "gtest/gtest.h"
 #include "util.hpp"
+#include "anagram.hpp"
+#include "flat_map.hpp"
+#include "mapped_file.hpp"
+#include "parallel.hpp"
+#include "pattern.hpp"
 
 /**************** Namespace Declarations ******************/
 using std::cout;
 using std::endl;
+using util::Signature;
+using util::SignatureHash;
+using util::pattern_t;
+using util::pattern_word;
+using util::pattern_number;
+using util::pattern_text;
+using util::NO_PATTERN;
 
 /************** Global Vars & Functions *******************/
 typedef std::size_t num_t;
 static const std::string INPUT = "./src/input_e098.txt";
 static const std::string CACHE_SQUARES = "./cache.98.private";
-static const std::vector<char> letters = {
-    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J',
-    'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T',
-    'U', 'V', 'W', 'X', 'Y', 'Z'
-};
+// Binary squares cache, bump the version whenever its layout changes.
+static const std::uint32_t CACHE_MAGIC = 0x38395153; // "SQ98" little endian
+static const std::uint32_t CACHE_VERSION = 2;
+static_assert(sizeof(num_t) == sizeof(std::uint64_t), "Cache stores squares as 64 bit words.");
+// Digits in the largest num_t.
+static const int MAX_DIGITS = 20;
+
+// Bits per digit count in a number signature, a 64 bit number has at most 20 digits.
+static const int DIGIT_BITS = 5;
 
 /**
  * @brief Hash a given number, all numbers that are anagrams will have same hash.
+ * Each digit's count takes DIGIT_BITS bits of the result, built in one pass.
  *
  * @param num The number to create a hash for.
  */
-std::string hash_number(num_t num) {
-    std::vector<num_t> digits;
+std::uint64_t hash_number(num_t num) {
+    std::uint64_t hash = 0;
     while (num != 0) {
-        digits.push_back(num % 10);
+        hash += 1ULL << (num % 10 * DIGIT_BITS);
         num /= 10;
     }
-    std::sort(digits.begin(), digits.end());
 
-    std::stringstream ss;
-    for (auto digit : digits) {
-        ss << digit;
-    }
-
-    return ss.str();
+    return hash;
 }
 
 /**
@@ -81,49 +100,94 @@ std::string hash_number(num_t num) {
  * For example:
  *    care, race, acre all have the same hash, acer
  *
- * @param word The string to look up.
+ * @param word The upper case word to hash, throws std::invalid_argument on other chars
+ *  or on a letter repeated more than 15 times, past what a signature counts.
  */
-std::string hash_word(const std::string &word) {
-    std::vector<char> letters;
-    std::copy(word.begin(), word.end(), std::back_inserter(letters));
-    std::sort(letters.begin(), letters.end());
-
-    std::stringstream ss;
-    for (auto letter : letters) {
-        ss << letter;
+Signature hash_word(const std::string &word) {
+    for (auto letter : word) {
+        if (letter < 'A' || letter > 'Z') {
+            throw std::invalid_argument("Words must be upper case letters: " + word);
+        }
     }
 
-    return ss.str();
+    Signature sig;
+    if (!util::letter_signature(word.data(), word.size(), sig)) {
+        throw std::invalid_argument("Words can't repeat a letter more than 15 times: " + word);
+    }
+    return sig;
 }
 
 /**
- * @brief Map any string to a universal form pattern that describes it.
+ * @brief Largest number with at most len digits, saturates at the largest num_t.
  *
- * Examples of this pattern mapping, string => string.
- * 1952 => ABCD
- * 1992 => ABBC
- * 1223 => ABBC
- * WILLING => ABCCBDE
- * CARE => ABCD
+ * @param len The digit length.
+ */
+num_t max_with_digits(num_t len) {
+    if (len >= MAX_DIGITS) {
+        return std::numeric_limits<num_t>::max();
+    }
+
+    num_t stop = 9;
+    while (len-- > 1) {
+        stop = stop * 10 + 9;
+    }
+
+    return stop;
+}
+
+/**
+ * @brief Exact integer square root, the largest root with root * root <= num.
  *
- * @param pattern The string describing the pattern.
+ * @param num The number to root.
  */
-std::string pattern_word(const std::string &word) {
-    std::stringstream ss;
-    std::map<num_t, char> chars_seen;
-    auto letter_itr = letters.begin();
-    for (auto letter : word) {
-        try {
-            chars_seen.at(letter);
-        } catch (std::out_of_range &exc) {
-            chars_seen[letter] = *letter_itr;
-            ++letter_itr;
+num_t isqrt(num_t num) {
+    if (num < 2) {
+        return num;
+    }
+
+    // Start at a power of 2 above the root, Newton's steps then fall onto it.
+    int bits = 64 - __builtin_clzll(num);
+    num_t root = num_t(1) << ((bits + 1) / 2);
+    while (true) {
+        num_t next = (root + num / root) / 2;
+        if (next >= root) {
+            return root;
         }
+        root = next;
+    }
+}
 
-        ss << chars_seen.at(letter);
+/**
+ * @brief Bit r is set when r is the residue of some square modulo mod, mod at most 64.
+ */
+constexpr std::uint64_t square_residues(unsigned mod) {
+    std::uint64_t mask = 0;
+    for (unsigned r = 0; r < mod; ++r) {
+        mask |= 1ULL << (r * r % mod);
+    }
+
+    return mask;
+}
+
+/**
+ * @brief Exact test for a perfect square.
+ *  Residues modulo 64, 63, 17 & 11 reject all but about 1 in 70 non squares
+ *  before the integer root is taken.
+ *
+ * @param num The number to test.
+ */
+bool exact_square(num_t num) {
+    static const std::uint64_t mod64 = square_residues(64);
+    static const std::uint64_t mod63 = square_residues(63);
+    static const std::uint64_t mod17 = square_residues(17);
+    static const std::uint64_t mod11 = square_residues(11);
+    if (!((mod64 >> (num & 63)) & 1) || !((mod63 >> (num % 63)) & 1) ||
+            !((mod17 >> (num % 17)) & 1) || !((mod11 >> (num % 11)) & 1)) {
+        return false;
     }
 
-    return ss.str();
+    num_t root = isqrt(num);
+    return root * root == num;
 }
 
 
@@ -134,15 +198,15 @@ public:
     num_t read_file(const std::string &filename);
     num_t longest_pair_size() const;
     inline
-    std::vector<std::string> get_by_hash(const std::string &key) const;
+    std::vector<std::string> get_by_hash(const Signature &key) const;
 
     friend std::ostream & operator<<(std::ostream &os, const AnagramContainer &anagrams);
 
     // Data
     // hash_word => list of similar hash strings
-    std::map<std::string, std::vector<std::string> > group_by_hash;
+    util::FlatMap<Signature, std::vector<std::string>, SignatureHash> group_by_hash;
     // pattern_word => list of patterned strings
-    std::map<std::string, std::vector<std::string> > group_by_pattern;
+    util::FlatMap<pattern_t, std::vector<std::string> > group_by_pattern;
 };
 
 /**
@@ -201,7 +265,7 @@ std::size_t AnagramContainer::longest_pair_size() const {
 }
 
 
-std::vector<std::string> AnagramContainer::get_by_hash(const std::string &key) const {
+std::vector<std::string> AnagramContainer::get_by_hash(const Signature &key) const {
     auto found = group_by_hash.find(key);
     if (found != group_by_hash.end()) {
         return found->second;
@@ -224,7 +288,7 @@ std::ostream & operator<<(std::ostream &os, const AnagramContainer &anagrams) {
     os << endl << "Patterns" << endl
         << "========" << endl;
     for (auto pattern : anagrams.group_by_pattern) {
-        os << "Pattern: " << pattern.first << endl << "  ";
+        os << "Pattern: " << pattern_text(pattern.first) << endl << "  ";
         for (auto word : pattern.second) {
             os << word << ", ";
         }
@@ -234,22 +298,73 @@ std::ostream & operator<<(std::ostream &os, const AnagramContainer &anagrams) {
     return os;
 }
 
+// Sorted view of the squares sharing one pattern, may point into a mapped cache.
+class SquareRange {
+public:
+    SquareRange(const num_t *first = NULL, const num_t *last = NULL) : first(first), last(last) {};
+    const num_t * begin() const { return first; }
+    const num_t * end() const { return last; }
+    std::size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+
+private:
+    const num_t *first;
+    const num_t *last;
+};
+
+// Binary cache layout: header, index sorted by pattern, then every pattern's squares.
+class CacheHeader {
+public:
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t max_length;
+    // Every square of up to this many digits was generated.
+    std::uint64_t full_length;
+    std::uint64_t num_patterns;
+    std::uint64_t num_squares;
+};
+
+class CacheEntry {
+public:
+    pattern_t pattern;
+    // Index of the first square & count, within the squares after the index.
+    std::uint64_t first;
+    std::uint64_t count;
+    // 1 if these are all the squares with the pattern.
+    std::uint64_t complete;
+};
+
 class SquaresContainer {
 public:
     inline
     void add_square(num_t number);
     void generate_below_length(num_t len);
     void generate_range(num_t start, num_t end);
-    void save(const std::string &filename) const;
-    void load(const std::string &filename);
+    bool require(const std::vector<pattern_t> &patterns, unsigned threads = 0);
+    bool is_complete(pattern_t pattern) const;
+    void save(const std::string &filename, num_t max_length) const;
+    bool load(const std::string &filename, num_t max_length);
     bool is_square(num_t number) const;
-    inline
-    std::vector<num_t> get_by_pattern(const std::string &pattern) const;
+    SquareRange get_by_pattern(pattern_t pattern) const;
+    std::vector<pattern_t> patterns() const;
 
     friend std::ostream & operator<<(std::ostream &os, const SquaresContainer &squares);
 
     // Data
-    std::map<std::string, std::vector<num_t> > group_by_pattern;
+    // Squares added since the last load, each pattern's squares in the order added.
+    util::FlatMap<pattern_t, std::vector<num_t> > group_by_pattern;
+
+private:
+    void unmap();
+    void generate_length(num_t len, const std::vector<pattern_t> &wanted, unsigned threads);
+
+    std::unique_ptr<util::MappedFile> mapped;
+    const CacheEntry *index = NULL;
+    const num_t *cached = NULL;
+    std::size_t num_patterns = 0;
+    // Patterns known to have all their squares, besides any of up to full_length digits.
+    util::FlatMap<pattern_t, bool> complete;
+    num_t full_length = 0;
 };
 
 /**
@@ -258,117 +373,292 @@ public:
  * @param number The squared number to add.
  */
 void SquaresContainer::add_square(num_t number) {
-    std::string key = pattern_word(std::to_string(number));
-    group_by_pattern[key].push_back(number);
+    if (mapped) {
+        unmap();
+    }
+    group_by_pattern[pattern_number(number)].push_back(number);
 }
 
 /**
  * @brief Generate all possible squares with a digit length less than len.
+ *  Squares follow (n + 1)^2 = n^2 + 2n + 1, all in exact integers.
  *
  * @param len The cutoff for digit length.
  */
 void SquaresContainer::generate_below_length(num_t len) {
-    double base = 0;
-    num_t stop = 9;
-    while (--len > 0) {
-        stop = stop * 10 + 9;
-    }
-
+    num_t stop = max_with_digits(len);
+    num_t squared = 1;
+    num_t step = 3;
     while (true) {
-        base++;
-        num_t squared = (num_t) std::pow(base, 2);
-        if (squared > stop) {
+        add_square(squared);
+        if (squared > stop - step) {
             break;
         }
-        add_square(squared);
+        squared += step;
+        step += 2;
     };
+    full_length = std::max(full_length, len);
 }
 
+/**
+ * @brief Generate the squares of every base in [start, end), end at most 2^32.
+ */
 void SquaresContainer::generate_range(num_t start, num_t end) {
-    double base = start;
-    double base_end = end;
+    if (start >= end) {
+        return;
+    }
 
-    while (base < base_end) {
-        num_t squared = (num_t) std::pow(base, 2);
+    num_t squared = start * start;
+    num_t step = 2 * start + 1;
+    for (num_t base = start; base < end; ++base) {
         add_square(squared);
-        ++base;
+        squared += step;
+        step += 2;
     };
 }
 
 /**
- * @brief Return the numbers matching the pattern requested.
+ * @brief Make sure every square with one of the patterns is held.
+ *  Only the digit lengths of patterns not already complete are generated,
+ *  each length once for all its patterns, so results are memoized across calls.
+ *
+ * @param patterns The patterns wanted, NO_PATTERN is ignored.
+ * @param threads Threads to generate with, 0 uses all hardware threads.
+ * @return True if any squares had to be generated, i.e. a saved cache is stale.
+ */
+bool SquaresContainer::require(const std::vector<pattern_t> &patterns, unsigned threads) {
+    std::map<num_t, std::vector<pattern_t> > by_length;
+    for (pattern_t pattern : patterns) {
+        if (pattern == NO_PATTERN || is_complete(pattern)) {
+            continue;
+        }
+
+        if (mapped) {
+            unmap();
+        }
+        complete[pattern] = true;
+        group_by_pattern[pattern].clear();
+        by_length[util::pattern_length(pattern)].push_back(pattern);
+    }
+
+    for (const auto &length : by_length) {
+        generate_length(length.first, length.second, threads);
+    }
+
+    return !by_length.empty();
+}
+
+/**
+ * @brief True if every square with the pattern is held.
+ *  Patterns with more than 10 symbols always are, no number has them.
+ */
+bool SquaresContainer::is_complete(pattern_t pattern) const {
+    return util::pattern_length(pattern) <= full_length || util::pattern_symbols(pattern) > 10
+        || complete.count(pattern);
+}
+
+/**
+ * @brief Add the squares with len digits whose pattern is wanted.
+ *  Roots are cut into shards that workers claim in turn, every shard collects
+ *  its own squares & shards are merged in order so each pattern stays sorted.
+ */
+void SquaresContainer::generate_length(num_t len, const std::vector<pattern_t> &wanted, unsigned threads) {
+    static const num_t SHARD_ROOTS = 1 << 16;
+    util::FlatMap<pattern_t, bool> lookup(wanted.size());
+    for (pattern_t pattern : wanted) {
+        lookup[pattern] = true;
+    }
+
+    const num_t first_root = len <= 1 ? 1 : isqrt(max_with_digits(len - 1)) + 1;
+    const num_t last_root = isqrt(max_with_digits(len));
+    if (first_root > last_root) {
+        return;
+    }
+    const std::size_t shards = (last_root - first_root) / SHARD_ROOTS + 1;
+
+    typedef std::vector<std::pair<pattern_t, num_t> > found_t;
+    std::vector<found_t> found(shards);
+    util::parallel_for(shards, threads,
+            [first_root, last_root, &lookup, &found](std::size_t shard, unsigned) {
+        num_t base = first_root + shard * SHARD_ROOTS;
+        const num_t end = std::min(base + SHARD_ROOTS - 1, last_root);
+        num_t squared = base * base;
+        num_t step = 2 * base + 1;
+        for (; base <= end; ++base) {
+            pattern_t pattern = pattern_number(squared);
+            if (lookup.count(pattern)) {
+                found[shard].push_back(std::make_pair(pattern, squared));
+            }
+            squared += step;
+            step += 2;
+        }
+    });
+
+    for (const found_t &shard : found) {
+        for (const auto &square : shard) {
+            group_by_pattern[square.first].push_back(square.second);
+        }
+    }
+}
+
+/**
+ * @brief Return the numbers matching the pattern requested, sorted.
+ *  The range is invalidated by the next add_square or load.
  *
  * @param pattern The pattern of the word.
  */
-std::vector<num_t> SquaresContainer::get_by_pattern(const std::string &pattern) const {
+SquareRange SquaresContainer::get_by_pattern(pattern_t pattern) const {
+    if (mapped) {
+        const CacheEntry *last = index + num_patterns;
+        const CacheEntry *found = std::lower_bound(index, last, pattern,
+                [](const CacheEntry &entry, pattern_t pattern) { return entry.pattern < pattern; });
+        if (found != last && found->pattern == pattern) {
+            return SquareRange(cached + found->first, cached + found->first + found->count);
+        }
+        return SquareRange();
+    }
+
     auto found = group_by_pattern.find(pattern);
     if (found != group_by_pattern.end()) {
-        return found->second;
+        return SquareRange(found->second.data(), found->second.data() + found->second.size());
     } else {
-        return std::vector<num_t>();;
+        return SquareRange();
     }
 }
 
 /**
- * @brief Save a cache of the computed squares for subsequent runs.
+ * @brief Every pattern held, in ascending order.
+ */
+std::vector<pattern_t> SquaresContainer::patterns() const {
+    std::vector<pattern_t> result;
+    if (mapped) {
+        for (std::size_t i = 0; i < num_patterns; ++i) {
+            result.push_back(index[i].pattern);
+        }
+    } else {
+        for (const auto &group : group_by_pattern) {
+            result.push_back(group.first);
+        }
+        std::sort(result.begin(), result.end());
+    }
+
+    return result;
+}
+
+/**
+ * @brief Save a binary cache of the computed squares for subsequent runs.
+ *  Squares are stored sorted per pattern behind an index sorted by pattern.
  *
  * @param filename The filename of the cache.
+ * @param max_length The digit length the squares were generated for, checked on load.
+ *  Which patterns are complete is kept, so require after a load only adds what's missing.
+ * @throws std::runtime_error If the cache can't be written, an existing one is left as it was.
  */
-void SquaresContainer::save(const std::string &filename) const {
-    std::ofstream fout(filename);
+void SquaresContainer::save(const std::string &filename, num_t max_length) const {
+    std::vector<CacheEntry> entries;
+    std::vector<num_t> squares;
+    for (pattern_t pattern : patterns()) {
+        SquareRange range = get_by_pattern(pattern);
+        CacheEntry entry = {pattern, squares.size(), range.size(), complete.count(pattern)};
+        entries.push_back(entry);
+        squares.insert(squares.end(), range.begin(), range.end());
+        std::sort(squares.end() - range.size(), squares.end());
+    }
 
-    for (auto group : group_by_pattern) {
-        fout << group.first << " ";
-        for (auto square : group.second) {
-            fout << square << " ";
-        }
-        fout << endl;
+    CacheHeader header = {CACHE_MAGIC, CACHE_VERSION, max_length, full_length,
+        entries.size(), squares.size()};
+    // Write beside the cache then rename, a run with the old one mapped keeps its pages.
+    std::string temp = filename + ".tmp";
+    std::ofstream fout(temp, std::ios::binary | std::ios::trunc);
+    fout.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    fout.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(CacheEntry));
+    fout.write(reinterpret_cast<const char *>(squares.data()), squares.size() * sizeof(num_t));
+    fout.close();
+    if (!fout || std::rename(temp.c_str(), filename.c_str()) != 0) {
+        std::remove(temp.c_str());
+        throw std::runtime_error("Unable to write squares cache: " + filename);
     }
 }
 
 /**
- * @brief Load the squares from the cache.
+ * @brief Map the squares from the cache, replacing any held now.
+ *  Nothing is copied, lookups read the mapped file.
  *
  * @param filename The filename of the cache.
+ * @param max_length The digit length wanted.
+ * @return False if the cache is missing, malformed, from another version or
+ *         made for another max_length. The container is left empty.
  */
-void SquaresContainer::load(const std::string &filename) {
-    std::ifstream fin(filename);
-    std::string line;
-
-    while (fin.good()) {
-        std::getline(fin, line);
-        std::stringstream ss(line);
-
-        std::string word, pattern;
-        ss >> pattern;
-        while (ss.good()) {
-            ss >> word;
-            num_t num = std::stoul(word);
-            if (num != 0) {
-                group_by_pattern[pattern].push_back(num);
-            }
+bool SquaresContainer::load(const std::string &filename, num_t max_length) {
+    group_by_pattern.clear();
+    mapped.reset();
+    index = NULL;
+    cached = NULL;
+    num_patterns = 0;
+    complete.clear();
+    full_length = 0;
+
+    std::unique_ptr<util::MappedFile> file;
+    try {
+        file.reset(new util::MappedFile(filename));
+    } catch (std::runtime_error &) {
+        return false;
+    }
+
+    CacheHeader header;
+    if (file->size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, file->data(), sizeof(header));
+    std::size_t expect = sizeof(header) + header.num_patterns * sizeof(CacheEntry) +
+        header.num_squares * sizeof(num_t);
+    if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION ||
+            header.max_length != max_length || file->size() != expect) {
+        return false;
+    }
+
+    // Header & entries are multiples of 8 bytes, so the squares stay aligned.
+    index = reinterpret_cast<const CacheEntry *>(file->data() + sizeof(header));
+    cached = reinterpret_cast<const num_t *>(index + header.num_patterns);
+    num_patterns = header.num_patterns;
+    mapped = std::move(file);
+    full_length = header.full_length;
+    for (std::size_t i = 0; i < num_patterns; ++i) {
+        if (index[i].complete) {
+            complete[index[i].pattern] = true;
         }
+    }
 
-    };
+    return true;
 }
 
-bool SquaresContainer::is_square(num_t number) const {
-    std::string temp = std::to_string(number);
-    auto found_nums = group_by_pattern.find(pattern_word(temp));
-    if (found_nums != group_by_pattern.end()) {
-        auto found = std::find(found_nums->second.begin(), found_nums->second.end(), number);
-        return found != found_nums->second.end();
+/**
+ * @brief Copy a mapped cache into group_by_pattern so it can grow.
+ */
+void SquaresContainer::unmap() {
+    std::unique_ptr<util::MappedFile> file = std::move(mapped);
+    for (std::size_t i = 0; i < num_patterns; ++i) {
+        group_by_pattern[index[i].pattern].assign(cached + index[i].first,
+                cached + index[i].first + index[i].count);
     }
+    index = NULL;
+    cached = NULL;
+    num_patterns = 0;
+}
 
-    return false;
+/**
+ * @brief True if number is a positive square, whether or not it was generated.
+ */
+bool SquaresContainer::is_square(num_t number) const {
+    return number != 0 && exact_square(number);
 }
 
 std::ostream & operator<<(std::ostream &os, const SquaresContainer &squares) {
     os << "Squares" << endl
         << "=======" << endl;
-    for (auto square : squares.group_by_pattern) {
-        os << "Pattern: " << square.first << endl << "  ";
-        for (auto word : square.second) {
+    for (auto pattern : squares.patterns()) {
+        os << "Pattern: " << pattern_text(pattern) << endl << "  ";
+        for (auto word : squares.get_by_pattern(pattern)) {
             os << word << ", ";
         }
         os << endl;
@@ -382,145 +672,155 @@ std::ostream & operator<<(std::ostream &os, const SquaresContainer &squares) {
  *  1) Set first word and chosen square, i.e. POST => 1024
  *  2) Add all other words that are anagrams of POST to set.
  *     During this addition, the values of the numbers will be computed and checked if square.
+ *
+ * The letter map is a flat array with a mask of digits in use, so a mapping that
+ * is not one to one is refused in set_first & nothing in the search allocates.
  */
 class Solution {
 public:
-    explicit Solution(const SquaresContainer &squares) : squares(squares), best_square(0) {};
-    explicit Solution(const Solution &other) : squares(other.squares) {
-        if (this != &other) {
-            *this = other;
-        }
-    }
-    explicit Solution(Solution &&other) : squares(other.squares) {
-        if (this != &other) {
-            *this = std::move(other);
-        }
-    }
+    explicit Solution(const SquaresContainer &squares) : squares(&squares), first_num(0),
+            best_square(0), used_digits(0) {
+        std::fill(char_to_num, char_to_num + NUM_LETTERS, NO_DIGIT);
+    };
 
-    void set_first(const std::string &word, num_t num);
+    bool set_first(const std::string &word, num_t num);
     num_t set_word(const std::string &word);
+    /* Digit letter maps to, NO_DIGIT if unmapped. */
+    int digit(char letter) const {
+        return char_to_num[letter - 'A'];
+    }
     // Determine if a square anagram is present.
     // At least two anagrams must map to square numbers.
-    inline
-    num_t is_square_anagram();
-    Solution & operator=(Solution &&other);
-    Solution & operator=(const Solution &other);
+    num_t is_square_anagram() const;
 
     friend std::ostream & operator<<(std::ostream &os, const Solution &squares);
 
     // Data
-    const SquaresContainer &squares;
+    static constexpr int NUM_LETTERS = 26;
+    static constexpr std::int8_t NO_DIGIT = -1;
+    const SquaresContainer *squares;
     std::string first_word;
+    num_t first_num;
+    // Largest square of another word under the map & that word.
     num_t best_square;
-    std::map<char, num_t> char_to_num;
-    std::map<std::string, num_t> word_nums;
+    std::string best_word;
+    std::int8_t char_to_num[NUM_LETTERS];
+    // Bit d set when some letter maps to digit d.
+    std::uint16_t used_digits;
 };
 
-void Solution::set_first(const std::string &word, num_t num) {
-    word_nums[word] = num;
+/**
+ * @brief Map the letters of word onto the digits of num.
+ *
+ * @return False if two letters would share a digit or one letter need two,
+ *  the map is then left partial & must not be used.
+ */
+bool Solution::set_first(const std::string &word, num_t num) {
     first_word = word;
+    first_num = num;
     best_square = 0;
+    best_word.clear();
+    std::fill(char_to_num, char_to_num + NUM_LETTERS, NO_DIGIT);
+    used_digits = 0;
 
     // Set the map for the first word to write others.
-    auto ritr = word.crbegin();
-    while (ritr != word.crend()) {
-        char_to_num[*ritr] = num % 10;
+    for (auto ritr = word.crbegin(); ritr != word.crend(); ++ritr) {
+        std::int8_t &mapped = char_to_num[*ritr - 'A'];
+        const int num_digit = num % 10;
         num /= 10;
-        ritr++;
+        if (mapped == NO_DIGIT) {
+            if (used_digits & (1u << num_digit)) {
+                return false;
+            }
+            mapped = num_digit;
+            used_digits |= 1u << num_digit;
+        } else if (mapped != num_digit) {
+            return false;
+        }
     }
+
+    return true;
 }
+
+/**
+ * @brief Number word becomes under the map, kept as best if a larger square.
+ *
+ * @return The number, 0 if a letter is unmapped or it would lead with a zero.
+ */
 num_t Solution::set_word(const std::string &word) {
+    // N.B. Stipulation of problem, leading zeroes aren't to be counted.
+    //      Rejected up front, before any number is formed.
+    if (word.empty() || char_to_num[word[0] - 'A'] <= 0) {
+        return 0;
+    }
+
     num_t num = 0;
-    bool leading_zero = false;
     for (auto char_ : word) {
-        num = num * 10 + char_to_num[char_];
-        if (num == 0) {
-            leading_zero = true;
+        const std::int8_t mapped = char_to_num[char_ - 'A'];
+        if (mapped == NO_DIGIT) {
+            return 0;
         }
+        num = num * 10 + mapped;
     }
 
-    // N.B. Stipulation of problem, leading zeroes aren't to be counted.
-    //      Technically in computer you are losing the 0 place.
-    if (!leading_zero && squares.is_square(num) && num > best_square) {
+    if (num > best_square && squares->is_square(num)) {
         best_square = num;
+        best_word = word;
     }
-    word_nums[word] = num;
     return num;
 }
 
 // Determine if a square anagram is present.
 // At least two anagrams must map to square numbers.
-num_t Solution::is_square_anagram() {
+num_t Solution::is_square_anagram() const {
     // best_square is set to max square seen that IS NOT first_word square. If not 0, have anagram group.
     if (best_square) {
-        return std::max(best_square, word_nums[first_word]);
+        return std::max(best_square, first_num);
     }
 
     return 0;
 }
 
-Solution & Solution::operator=(const Solution &other) {
-    if (this == &other) {
-        return *this;
-    }
-
-    first_word = other.first_word;
-    best_square = other.best_square;
-    char_to_num.clear();
-    for (auto pair : other.char_to_num) {
-        char_to_num[pair.first] = pair.second;
-    }
-    word_nums.clear();
-    for (auto pair : other.word_nums) {
-        word_nums[pair.first] = pair.second;
-    }
-
-    return *this;
-}
-
-Solution & Solution::operator=(Solution &&other) {
-    if (this == &other) {
-        return *this;
-    }
-
-    std::swap(other.best_square, this->best_square);
-    std::swap(other.first_word, this->first_word);
-    std::swap(other.char_to_num, this->char_to_num);
-    std::swap(other.word_nums, this->word_nums);
-
-    return *this;
-}
-
 std::ostream & operator<<(std::ostream &os, const Solution &sol) {
     os << "Base Word: " << sol.first_word << endl;
     os << "Base Map: " << endl;
     std::string pad = "    ";
-    for (auto pair : sol.char_to_num) {
-        os << pad << pair.first << " => " << pair.second << endl;
+    for (int letter = 0; letter < Solution::NUM_LETTERS; ++letter) {
+        if (sol.char_to_num[letter] != Solution::NO_DIGIT) {
+            os << pad << static_cast<char>('A' + letter) << " => "
+                << static_cast<int>(sol.char_to_num[letter]) << endl;
+        }
     }
 
-    for (auto pair : sol.word_nums) {
-        os << pair.first << " -> " << pair.second << " is square: " << sol.squares.is_square(pair.second) << endl;
+    os << sol.first_word << " -> " << sol.first_num << " is square: "
+        << sol.squares->is_square(sol.first_num) << endl;
+    if (sol.best_square) {
+        os << sol.best_word << " -> " << sol.best_square << " is square: 1" << endl;
     }
 
     return os;
 }
 
 num_t find_possible_square_pairs(const AnagramContainer &anagrams, const SquaresContainer &squares,
-        const std::string &hash_key, Solution &r_sol) {
+        const Signature &hash_key, Solution &r_sol) {
     num_t best = 0;
-    auto words = anagrams.get_by_hash(hash_key);
-
-    for (std::size_t i = 0; i < words.size(); ++i) {
-        std::string first = words.back();
-        words.pop_back();
-        const auto &squares_first = squares.get_by_pattern(pattern_word(first));
-        Solution sol(squares);
+    auto found = anagrams.group_by_hash.find(hash_key);
+    if (found == anagrams.group_by_hash.end()) {
+        return best;
+    }
+    const std::vector<std::string> &words = found->second;
 
-        for (auto square : squares_first) {
-            sol.set_first(first, square);
-            for (auto word : words) {
-                sol.set_word(word);
+    // Every word takes a turn as first, the rest are tried against its mapping.
+    Solution sol(squares);
+    for (std::size_t first = 0; first < words.size(); ++first) {
+        for (auto square : squares.get_by_pattern(pattern_word(words[first]))) {
+            if (!sol.set_first(words[first], square)) {
+                continue;
+            }
+            for (std::size_t other = 0; other < words.size(); ++other) {
+                if (other != first) {
+                    sol.set_word(words[other]);
+                }
             }
 
             if (sol.is_square_anagram() && sol.is_square_anagram() > best) {
@@ -528,8 +828,6 @@ num_t find_possible_square_pairs(const AnagramContainer &anagrams, const Squares
                 r_sol = sol;
             }
         }
-
-        words.insert(words.begin(), first);
     }
 
     return best;
@@ -537,58 +835,115 @@ num_t find_possible_square_pairs(const AnagramContainer &anagrams, const Squares
 
 /**
  * @brief Solve the problem.
+ *  Anagram groups are searched on a pool of threads, each keeping its own best.
+ *  The bests are reduced at the end, ties going to the earliest group.
  *
+ * @param best_sol Set to the solution of the winning group.
+ * @param threads Threads to search with, 0 uses all hardware threads.
  * @return The largest number that fit into an anagram pair.
  */
-num_t largest_square_number(Solution &best_sol) {
+num_t largest_square_number(Solution &best_sol, unsigned threads = 0) {
     AnagramContainer anagrams;
     num_t max = anagrams.read_file(INPUT);
 
-    SquaresContainer squares;
-    std::ifstream check(CACHE_SQUARES);
-    if (check.good()) {
-        squares.load(CACHE_SQUARES);
-    } else {
-        // TODO: Can this go faster? Apart from just parallelize.
-        squares.generate_below_length(max);
-        squares.save(CACHE_SQUARES);
+    std::vector<Signature> groups;
+    std::vector<pattern_t> patterns;
+    for (const auto &group : anagrams.group_by_hash) {
+        if (group.second.size() >= 2) {
+            groups.push_back(group.first);
+            for (const std::string &word : group.second) {
+                patterns.push_back(pattern_word(word));
+            }
+        }
     }
 
-    num_t biggest_square = 0;
-    for (auto group : anagrams.group_by_hash) {
-        if (group.second.size() < 2) {
-            continue;
+    // Only squares some paired word could take are generated, the cache keeps them for next time.
+    SquaresContainer squares;
+    squares.load(CACHE_SQUARES, max);
+    if (squares.require(patterns, threads)) {
+        try {
+            squares.save(CACHE_SQUARES, max);
+        } catch (const std::runtime_error &error) {
+            // The answer doesn't need the cache, the next run just generates again.
+            std::cerr << error.what() << std::endl;
         }
+    }
 
+    // Per worker best as (square, group index).
+    typedef std::pair<num_t, std::size_t> best_t;
+    std::vector<best_t> bests(util::worker_count(threads, groups.size()), best_t(0, groups.size()));
+    util::parallel_for(groups.size(), threads,
+            [&anagrams, &squares, &groups, &bests](std::size_t index, unsigned worker) {
         Solution sol(squares);
-        num_t best = find_possible_square_pairs(anagrams, squares, group.first, sol);
-        if (best != 0 && best > biggest_square) {
-            biggest_square = best;
-            best_sol = sol;
+        num_t best = find_possible_square_pairs(anagrams, squares, groups[index], sol);
+        if (best > bests[worker].first ||
+                (best != 0 && best == bests[worker].first && index < bests[worker].second)) {
+            bests[worker] = best_t(best, index);
+        }
+    });
+
+    best_t winner(0, groups.size());
+    for (const best_t &best : bests) {
+        if (best.first > winner.first || (best.first == winner.first && best.second < winner.second)) {
+            winner = best;
         }
     }
+    if (winner.first == 0) {
+        return 0;
+    }
 
+    // Only the winning group's solution is kept, rebuild it once.
+    find_possible_square_pairs(anagrams, squares, groups[winner.second], best_sol);
     return best_sol.is_square_anagram();
 }
 
 TEST(Euler098, HashNumber) {
-    std::string expect("34799");
+    std::uint64_t expect = (1ULL << 3 * DIGIT_BITS) + (1ULL << 4 * DIGIT_BITS) +
+        (1ULL << 7 * DIGIT_BITS) + (2ULL << 9 * DIGIT_BITS);
     ASSERT_EQ(hash_number(99734), expect);
+    ASSERT_EQ(hash_number(99734), hash_number(47939));
+    ASSERT_NE(hash_number(99734), hash_number(99735));
+    ASSERT_EQ(hash_number(11111111111111111111ULL) >> DIGIT_BITS, 20);
 }
 
 TEST(Euler098, HashWord) {
-    std::string expect("ACER");
     const std::string input("RACE");
-    ASSERT_EQ(hash_word(input), expect);
+    ASSERT_EQ(hash_word(input), hash_word("ACER"));
+    ASSERT_NE(hash_word(input), hash_word("RACES"));
+    ASSERT_NE(hash_word("AA"), hash_word("B"));
+    ASSERT_NE(hash_word("QUIZ"), hash_word("QUIT"));
+    ASSERT_THROW(hash_word("race"), std::invalid_argument);
+    ASSERT_NO_THROW(hash_word(std::string(15, 'E')));
+    ASSERT_THROW(hash_word(std::string(16, 'E')), std::invalid_argument);
+
+    std::stringstream ss;
+    ss << hash_word(input);
+    ASSERT_EQ(ss.str(), "ACER");
 }
 
 TEST(Euler098, PatternWord) {
     std::string expect("ABCD");
-    ASSERT_EQ(pattern_word(std::string("1952")), expect);
+    ASSERT_EQ(pattern_text(pattern_word(std::string("1952"))), expect);
+    ASSERT_EQ(pattern_word(std::string("1952")), 0x4321);
     expect = "ABBC";
-    ASSERT_EQ(pattern_word(std::string("1992")), expect);
+    ASSERT_EQ(pattern_text(pattern_word(std::string("1992"))), expect);
     expect = "ABCCBDE";
-    ASSERT_EQ(pattern_word(std::string("WILLING")), expect);
+    ASSERT_EQ(pattern_text(pattern_word(std::string("WILLING"))), expect);
+    ASSERT_EQ(pattern_word(std::string("CARE")), pattern_word(std::string("1952")));
+
+    // A trailing repeat must not look like a shorter word.
+    ASSERT_NE(pattern_word(std::string("AB")), pattern_word(std::string("ABA")));
+    ASSERT_EQ(pattern_word(std::string("")), NO_PATTERN);
+    ASSERT_EQ(pattern_word(std::string("ABCDEFGHIJKLMNOA")), 0x1FEDCBA987654321ULL);
+    ASSERT_EQ(pattern_word(std::string("ABCDEFGHIJKLMNOP")), NO_PATTERN);
+    ASSERT_EQ(pattern_word(std::string("AAAAAAAAAAAAAAAAA")), NO_PATTERN);
+}
+
+TEST(Euler098, PatternNumber) {
+    ASSERT_EQ(pattern_number(1992), pattern_word(std::string("1992")));
+    ASSERT_EQ(pattern_number(0), pattern_word(std::string("0")));
+    ASSERT_EQ(pattern_text(pattern_number(1000000007)), "ABBBBBBBBC");
+    ASSERT_EQ(pattern_number(18446744073709551615ULL), NO_PATTERN);
 }
 
 TEST(Euler098, AnagramCreate) {
@@ -598,8 +953,7 @@ TEST(Euler098, AnagramCreate) {
     anagrams.add_word(std::string("RACE"));
     anagrams.add_word(std::string("WILLING"));
 
-    std::string look = "ABCD";
-    auto found = anagrams.group_by_pattern.find(look);
+    auto found = anagrams.group_by_pattern.find(pattern_word(std::string("ABCD")));
     ASSERT_EQ(found->second[0], "CARE");
 }
 
@@ -617,8 +971,7 @@ TEST(Euler098, AnagramReadFile) {
     AnagramContainer anagrams;
     anagrams.read_file(INPUT);
 
-    std::string look = "ABCDEFGHIJ";
-    auto found = anagrams.group_by_pattern.find(look);
+    auto found = anagrams.group_by_pattern.find(pattern_word(std::string("ABCDEFGHIJ")));
     ASSERT_EQ(found->second[0], "BACKGROUND");
 }
 
@@ -637,7 +990,7 @@ TEST(Euler098, SquaresGenerateRange) {
     squares.generate_range(1, 100);
 
     std::vector<num_t> expect = {16, 25, 36, 49, 64, 81};
-    ASSERT_EQ(squares.group_by_pattern["AB"], expect);
+    ASSERT_EQ(squares.group_by_pattern[pattern_word(std::string("AB"))], expect);
 }
 
 TEST(Euler098, SquaresGenerateBelow) {
@@ -645,7 +998,7 @@ TEST(Euler098, SquaresGenerateBelow) {
     squares.generate_below_length(5);
 
     std::vector<num_t> expect = {1225, 2116, 4225, 5776, 6889, 7225};
-    ASSERT_EQ(squares.group_by_pattern["ABBC"], expect);
+    ASSERT_EQ(squares.group_by_pattern[pattern_word(std::string("ABBC"))], expect);
 }
 
 TEST(Euler098, SquaresIsSquare) {
@@ -656,15 +1009,164 @@ TEST(Euler098, SquaresIsSquare) {
     ASSERT_EQ(squares.is_square(1024), 1);
 }
 
+TEST(Euler098, ExactSquare) {
+    for (num_t root = 0; root < 5000; ++root) {
+        ASSERT_EQ(isqrt(root * root), root);
+        ASSERT_TRUE(exact_square(root * root));
+        if (root > 1) {
+            ASSERT_FALSE(exact_square(root * root - 1));
+            ASSERT_FALSE(exact_square(root * root + 1));
+        }
+    }
+
+    // Past 2^53 doubles can't tell these apart.
+    num_t root = 3037000499ULL;
+    ASSERT_TRUE(exact_square(root * root));
+    ASSERT_FALSE(exact_square(root * root - 1));
+    ASSERT_FALSE(exact_square(root * root + 1));
+    ASSERT_EQ(isqrt(root * root - 1), root - 1);
+    ASSERT_EQ(isqrt(std::numeric_limits<num_t>::max()), 4294967295ULL);
+    ASSERT_FALSE(exact_square(std::numeric_limits<num_t>::max()));
+    ASSERT_TRUE(exact_square(4294967295ULL * 4294967295ULL));
+}
+
+TEST(Euler098, MaxWithDigits) {
+    ASSERT_EQ(max_with_digits(1), 9);
+    ASSERT_EQ(max_with_digits(4), 9999);
+    ASSERT_EQ(max_with_digits(19), 9999999999999999999ULL);
+    ASSERT_EQ(max_with_digits(20), std::numeric_limits<num_t>::max());
+}
+
+TEST(Euler098, SquaresGenerateLarge) {
+    SquaresContainer squares;
+    squares.generate_range(94906265, 94906270);
+
+    // 94906267^2 is 9007199515875289, past 2^53 so pow on doubles rounds it.
+    auto range = squares.get_by_pattern(pattern_number(9007199515875289ULL));
+    ASSERT_TRUE(std::binary_search(range.begin(), range.end(), 9007199515875289ULL));
+    ASSERT_TRUE(squares.is_square(9007199515875289ULL));
+    ASSERT_FALSE(squares.is_square(9007199515875288ULL));
+    ASSERT_FALSE(squares.is_square(0));
+}
+
+TEST(Euler098, SquaresSaveLoad) {
+    static const std::string fname = "/tmp/euler098_squares_test.private";
+    SquaresContainer squares;
+    squares.generate_below_length(4);
+    squares.save(fname, 4);
+
+    SquaresContainer loaded;
+    ASSERT_TRUE(loaded.load(fname, 4));
+    ASSERT_EQ(loaded.patterns(), squares.patterns());
+    auto range = loaded.get_by_pattern(pattern_word(std::string("ABBC")));
+    std::vector<num_t> expect = {1225, 2116, 4225, 5776, 6889, 7225};
+    ASSERT_EQ(std::vector<num_t>(range.begin(), range.end()), expect);
+    ASSERT_TRUE(loaded.is_square(9604));
+    ASSERT_FALSE(loaded.is_square(9605));
+    ASSERT_TRUE(loaded.get_by_pattern(pattern_word(std::string("ABCDE"))).empty());
+
+    // Adding to a mapped cache copies it out first.
+    loaded.add_square(10000);
+    ASSERT_TRUE(loaded.is_square(9604));
+    ASSERT_TRUE(loaded.is_square(10000));
+
+    // Saving over a mapped cache swaps the file in, the mapping keeps reading the old one.
+    ASSERT_TRUE(loaded.load(fname, 4));
+    SquaresContainer smaller;
+    smaller.generate_below_length(2);
+    smaller.save(fname, 4);
+    ASSERT_TRUE(loaded.is_square(9604));
+    ASSERT_THROW(squares.save("/tmp/euler098_missing_dir/squares.private", 4), std::runtime_error);
+
+    // Other parameters, versions or garbage are rejected, leaving it empty.
+    ASSERT_FALSE(loaded.load(fname, 5));
+    ASSERT_TRUE(loaded.patterns().empty());
+    std::ofstream(fname) << "A 1 4 9";
+    ASSERT_FALSE(loaded.load(fname, 4));
+    std::remove(fname.c_str());
+    ASSERT_FALSE(loaded.load(fname, 4));
+}
+
+TEST(Euler098, SquaresRequire) {
+    SquaresContainer squares;
+    pattern_t abbc = pattern_word(std::string("ABBC"));
+    ASSERT_TRUE(squares.require({abbc}, 2));
+    auto range = squares.get_by_pattern(abbc);
+    std::vector<num_t> expect = {1225, 2116, 4225, 5776, 6889, 7225};
+    ASSERT_EQ(std::vector<num_t>(range.begin(), range.end()), expect);
+    ASSERT_TRUE(squares.is_complete(abbc));
+    ASSERT_FALSE(squares.is_complete(pattern_word(std::string("ABCD"))));
+    ASSERT_FALSE(squares.require({abbc}, 2));
+
+    // No number has 11 distinct digits, nothing is generated so no cache would be stale.
+    pattern_t eleven = pattern_word(std::string("ABCDEFGHIJK"));
+    ASSERT_FALSE(squares.require({eleven}));
+    ASSERT_TRUE(squares.is_complete(eleven));
+    ASSERT_TRUE(squares.get_by_pattern(eleven).empty());
+}
+
+TEST(Euler098, SquaresRequireMatchesFull) {
+    SquaresContainer full;
+    full.generate_below_length(7);
+    std::vector<pattern_t> patterns = {
+        pattern_word(std::string("ABCDEF")), pattern_word(std::string("ABCABC")),
+        pattern_word(std::string("AABBCC")), pattern_word(std::string("A")),
+    };
+
+    for (unsigned threads : {1, 4}) {
+        SquaresContainer lazy;
+        lazy.require(patterns, threads);
+        for (pattern_t pattern : patterns) {
+            auto got = lazy.get_by_pattern(pattern), want = full.get_by_pattern(pattern);
+            ASSERT_EQ(std::vector<num_t>(got.begin(), got.end()),
+                    std::vector<num_t>(want.begin(), want.end()));
+        }
+    }
+}
+
+TEST(Euler098, SquaresRequireAfterLoad) {
+    static const std::string fname = "/tmp/euler098_require_test.private";
+    pattern_t abcd = pattern_word(std::string("ABCD"));
+    pattern_t abcde = pattern_word(std::string("ABCDE"));
+    SquaresContainer squares;
+    squares.require({abcd, pattern_word(std::string("AAAA"))});
+    squares.save(fname, 4);
+
+    SquaresContainer loaded;
+    ASSERT_TRUE(loaded.load(fname, 4));
+    ASSERT_TRUE(loaded.is_complete(pattern_word(std::string("AAAA"))));
+    ASSERT_FALSE(loaded.require({abcd}));
+    ASSERT_EQ(loaded.get_by_pattern(abcd).size(), squares.get_by_pattern(abcd).size());
+    ASSERT_TRUE(loaded.require({abcde}));
+    ASSERT_EQ(loaded.get_by_pattern(abcd).size(), squares.get_by_pattern(abcd).size());
+    ASSERT_FALSE(loaded.get_by_pattern(abcde).empty());
+    std::remove(fname.c_str());
+}
+
 TEST(Euler098, SolutionSetFirst) {
     SquaresContainer squares;
     squares.generate_range(1, 2000);
     Solution sol(squares);
-    sol.set_first("POST", 1024);
+    ASSERT_TRUE(sol.set_first("POST", 1024));
 
-    ASSERT_EQ(sol.word_nums["POST"], 1024);
+    ASSERT_EQ(sol.first_num, 1024);
     ASSERT_EQ(sol.first_word, "POST");
-    ASSERT_EQ(sol.char_to_num['P'], 1);
+    ASSERT_EQ(sol.digit('P'), 1);
+    ASSERT_EQ(sol.digit('T'), 4);
+    ASSERT_EQ(sol.digit('A'), Solution::NO_DIGIT);
+    ASSERT_EQ(sol.used_digits, (1 << 0) | (1 << 1) | (1 << 2) | (1 << 4));
+}
+
+TEST(Euler098, SolutionSetFirstBijection) {
+    SquaresContainer squares;
+    squares.generate_range(1, 2000);
+    Solution sol(squares);
+
+    // One letter can't take two digits, nor two letters one digit.
+    ASSERT_FALSE(sol.set_first("POOL", 1234));
+    ASSERT_FALSE(sol.set_first("POST", 1121));
+    ASSERT_TRUE(sol.set_first("POOL", 1225));
+    ASSERT_EQ(sol.digit('O'), 2);
 }
 
 TEST(Euler098, SolutionSetWord) {
@@ -674,8 +1176,12 @@ TEST(Euler098, SolutionSetWord) {
     sol.set_first("POST", 1024);
 
     ASSERT_EQ(sol.set_word("STOP"), 2401);
-    ASSERT_EQ(sol.word_nums["POST"], 1024);
-    ASSERT_EQ(sol.word_nums["STOP"], 2401);
+    ASSERT_EQ(sol.best_square, 2401);
+    ASSERT_EQ(sol.best_word, "STOP");
+    // Leading zero & unmapped letters are refused without a number.
+    ASSERT_EQ(sol.set_word("OPTS"), 0);
+    ASSERT_EQ(sol.set_word("PAST"), 0);
+    ASSERT_EQ(sol.best_square, 2401);
 }
 
 TEST(Euler098, SolutionIsSquareAnagram) {
@@ -720,6 +1226,10 @@ TEST(Euler098, SolutionOperatorAssign) {
 
     sol = sol2;
     cout << sol << endl << sol2;
+    ASSERT_EQ(sol.first_word, "CARE");
+    ASSERT_EQ(sol.digit('C'), 4);
+    ASSERT_EQ(sol.digit('P'), Solution::NO_DIGIT);
+    ASSERT_EQ(sol.is_square_anagram(), sol2.is_square_anagram());
 }
 
 TEST(Euler098, SolutionOperatorMove) {
@@ -736,6 +1246,9 @@ TEST(Euler098, SolutionOperatorMove) {
     cout << "Move sol2 into sol" << endl;
     sol = std::move(sol2);
     cout << sol << endl << sol2;
+    ASSERT_EQ(sol.first_word, "CARE");
+    ASSERT_EQ(sol.first_num, 4096);
+    ASSERT_EQ(sol.digit('E'), 6);
 }
 
 TEST(Euler098, FindPossibleSquarePairs) {
@@ -752,6 +1265,15 @@ TEST(Euler098, FindPossibleSquarePairs) {
     ASSERT_EQ(result, 9604);
 }
 
+TEST(Euler098, FinalAnswerThreads) {
+    for (unsigned threads : {1, 2, 4}) {
+        SquaresContainer squares;
+        Solution sol(squares);
+        ASSERT_EQ(largest_square_number(sol, threads), 18769);
+        ASSERT_EQ(sol.first_word.size(), 5);
+    }
+}
+
 TEST(Euler098, FinalAnswer) {
     SquaresContainer squares;
     Solution sol(squares);
@@ -760,3 +1282,35 @@ TEST(Euler098, FinalAnswer) {
     ASSERT_EQ(result, 18769);
     cout << sol << endl;
 }
+
+#ifdef BENCH
+////////////
+// Benchmarks, only built into Bench098.exe
+////////////
+TEST(Bench098, AnagramIndex) {
+    // Every arrangement of 8 distinct letters plus a spread of other classes.
+    std::string text;
+    std::string letters = "ABCDEFGH";
+    do {
+        text += letters + '\n';
+    } while (std::next_permutation(letters.begin(), letters.end()));
+    for (int i = 0; i < 100000; ++i) {
+        text += std::string(1, 'A' + i % 26) + std::string(1, 'A' + i / 26 % 26) +
+            std::string(1, 'A' + i / 676 % 26) + "Z\n";
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    util::AnagramIndex index(text.data(), text.size());
+    auto built = std::chrono::steady_clock::now();
+    std::size_t found = 0;
+    for (int i = 0; i < 1000; ++i) {
+        found += index.anagrams("HGFEDCBA").size();
+    }
+    auto queried = std::chrono::steady_clock::now();
+
+    ASSERT_EQ(found, 40320 * 1000);
+    cout << "Indexed " << index.num_words() << " words in "
+        << std::chrono::duration<double, std::milli>(built - start).count() << "ms, query took "
+        << std::chrono::duration<double, std::micro>(queried - built).count() / 1000 << "us" << endl;
+}
+#endif
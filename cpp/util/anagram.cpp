@@ -0,0 +1,318 @@
+/**
+ * Anagram classes over large word lists, with an on disk form that maps in place.
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include "anagram.hpp"
+#include "flat_map.hpp"
+
+namespace util {
+
+/***************** Constants & Macros *********************/
+static const std::uint32_t ANAGRAM_MAGIC = 0x47414E41; // "ANAG" little endian
+
+/******************* Type Definitions *********************/
+struct AnagramHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t num_classes;
+    std::uint64_t num_words;
+    std::uint64_t arena_size;
+    std::uint64_t largest;
+};
+
+/* A word still in the source text. */
+struct Token {
+    const char *text;
+    std::uint32_t length;
+    std::uint32_t class_id;
+};
+
+/************** Global Vars & Functions *******************/
+bool letter_signature(const char *word, std::size_t length, Signature &sig) {
+    sig = Signature();
+    bool any = false;
+    for (std::size_t i = 0; i < length; ++i) {
+        // Fold to upper case, anything else is not a letter.
+        int letter = (word[i] | 0x20) - 'a';
+        if (letter < 0 || letter >= NUM_LETTERS) {
+            continue;
+        }
+
+        std::uint64_t &packed = letter < LETTERS_PER_WORD ? sig.low : sig.high;
+        const int shift = letter % LETTERS_PER_WORD * LETTER_BITS;
+        if (((packed >> shift) & ((1 << LETTER_BITS) - 1)) == (1 << LETTER_BITS) - 1) {
+            return false;
+        }
+        packed += 1ULL << shift;
+        any = true;
+    }
+
+    return any;
+}
+
+std::ostream & operator<<(std::ostream &os, const Signature &sig) {
+    for (int letter = 0; letter < NUM_LETTERS; ++letter) {
+        std::uint64_t word = letter < LETTERS_PER_WORD ? sig.low : sig.high;
+        int count = (word >> (letter % LETTERS_PER_WORD * LETTER_BITS)) & ((1 << LETTER_BITS) - 1);
+        os << std::string(count, 'A' + letter);
+    }
+
+    return os;
+}
+
+std::string AnagramClass::word(std::size_t index) const {
+    return std::string(arena + refs[2 * index], refs[2 * index + 1]);
+}
+
+std::vector<std::string> AnagramClass::words() const {
+    std::vector<std::string> result;
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back(word(i));
+    }
+
+    return result;
+}
+
+inline bool is_separator(char letter) {
+    return letter == ' ' || letter == '\n' || letter == '\r' || letter == '\t' ||
+        letter == ',' || letter == '"';
+}
+
+inline bool token_less(const Token &left, const Token &right) {
+    int cmp = std::memcmp(left.text, right.text, std::min(left.length, right.length));
+    return cmp < 0 || (cmp == 0 && left.length < right.length);
+}
+
+inline bool token_equal(const Token &left, const Token &right) {
+    return left.length == right.length && std::memcmp(left.text, right.text, left.length) == 0;
+}
+
+AnagramIndex::AnagramIndex(const std::string &filename) : mapped(new MappedFile(filename)) {
+    AnagramHeader header;
+    if (mapped->size() < sizeof(header)) {
+        throw std::runtime_error("Anagram index is truncated: " + filename);
+    }
+
+    std::memcpy(&header, mapped->data(), sizeof(header));
+    // Counts past the file size could wrap the expected size around to a match.
+    const std::uint64_t limit = mapped->size();
+    std::uint64_t expect = sizeof(header) + header.num_classes * sizeof(ClassEntry) +
+        header.num_words * 2 * sizeof(std::uint32_t) + header.arena_size;
+    if (header.magic != ANAGRAM_MAGIC || header.version != ANAGRAM_VERSION ||
+            header.num_classes > limit || header.num_words > limit || header.arena_size > limit ||
+            mapped->size() != expect) {
+        throw std::runtime_error("Anagram index header mismatch: " + filename);
+    }
+    point_at(mapped->data());
+
+    // A file of the right size may still be stale or corrupt, every view must stay in bounds.
+    bool valid = classes_size == 0 || largest < classes_size;
+    for (std::size_t index = 0; valid && index < classes_size; ++index) {
+        valid = std::uint64_t(classes[index].first) + classes[index].count <= words_size;
+    }
+    for (std::size_t index = 0; valid && index < words_size; ++index) {
+        valid = std::uint64_t(refs[2 * index]) + refs[2 * index + 1] <= header.arena_size;
+    }
+    if (!valid) {
+        throw std::runtime_error("Anagram index is corrupt: " + filename);
+    }
+}
+
+AnagramIndex::AnagramIndex(const char *text, std::size_t size) {
+    // Split the text & give every distinct signature a class id in order of appearance.
+    FlatMap<Signature, std::uint32_t, SignatureHash> class_ids;
+    std::vector<Signature> signatures;
+    std::vector<Token> tokens;
+    const char *end = text + size;
+    for (const char *pos = text; pos != end; ) {
+        if (is_separator(*pos)) {
+            ++pos;
+            continue;
+        }
+
+        const char *start = pos;
+        while (pos != end && !is_separator(*pos)) {
+            ++pos;
+        }
+        Signature sig;
+        if (!letter_signature(start, pos - start, sig)) {
+            continue;
+        }
+
+        auto found = class_ids.find(sig);
+        std::uint32_t class_id;
+        if (found == class_ids.end()) {
+            class_id = signatures.size();
+            class_ids[sig] = class_id;
+            signatures.push_back(sig);
+        } else {
+            class_id = found->second;
+        }
+        tokens.push_back(Token {start, static_cast<std::uint32_t>(pos - start), class_id});
+    }
+
+    // Renumber classes in signature order, then bucket the tokens by class.
+    std::vector<std::uint32_t> order(signatures.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&signatures](std::uint32_t left, std::uint32_t right) {
+        return signatures[left] < signatures[right];
+    });
+    std::vector<std::uint32_t> rank(order.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        rank[order[i]] = i;
+    }
+
+    std::vector<std::size_t> bucket(order.size() + 1, 0);
+    for (const Token &token : tokens) {
+        ++bucket[rank[token.class_id] + 1];
+    }
+    for (std::size_t i = 1; i < bucket.size(); ++i) {
+        bucket[i] += bucket[i - 1];
+    }
+    std::vector<Token> sorted(tokens.size());
+    {
+        std::vector<std::size_t> next(bucket.begin(), bucket.end() - 1);
+        for (const Token &token : tokens) {
+            sorted[next[rank[token.class_id]]++] = token;
+        }
+    }
+    std::vector<Token>().swap(tokens);
+
+    // Sort each class's words & drop exact repeats.
+    std::vector<ClassEntry> entries(order.size());
+    std::vector<Token> unique;
+    unique.reserve(sorted.size());
+    std::uint64_t arena_size = 0;
+    std::size_t largest_class = 0;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        auto first = sorted.begin() + bucket[i], last = sorted.begin() + bucket[i + 1];
+        std::sort(first, last, token_less);
+        last = std::unique(first, last, token_equal);
+
+        entries[i].low = signatures[order[i]].low;
+        entries[i].high = signatures[order[i]].high;
+        entries[i].first = unique.size();
+        entries[i].count = last - first;
+        for (auto itr = first; itr != last; ++itr) {
+            arena_size += itr->length;
+        }
+        unique.insert(unique.end(), first, last);
+        if (entries[i].count > entries[largest_class].count) {
+            largest_class = i;
+        }
+    }
+    if (arena_size > std::numeric_limits<std::uint32_t>::max() ||
+            unique.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("Word list too large, the arena is limited to 4 GiB.");
+    }
+
+    // Lay out the same image save writes.
+    AnagramHeader header = {ANAGRAM_MAGIC, ANAGRAM_VERSION, entries.size(), unique.size(),
+        arena_size, largest_class};
+    const std::size_t refs_offset = sizeof(header) + entries.size() * sizeof(ClassEntry);
+    const std::size_t arena_offset = refs_offset + unique.size() * 2 * sizeof(std::uint32_t);
+    owned.resize(arena_offset + arena_size);
+    std::memcpy(owned.data(), &header, sizeof(header));
+    std::memcpy(owned.data() + sizeof(header), entries.data(), entries.size() * sizeof(ClassEntry));
+    std::uint32_t *word_refs = reinterpret_cast<std::uint32_t *>(owned.data() + refs_offset);
+    std::uint32_t offset = 0;
+    for (std::size_t i = 0; i < unique.size(); ++i) {
+        std::memcpy(owned.data() + arena_offset + offset, unique[i].text, unique[i].length);
+        word_refs[2 * i] = offset;
+        word_refs[2 * i + 1] = unique[i].length;
+        offset += unique[i].length;
+    }
+    point_at(owned.data());
+}
+
+/* Point the views at an image laid out as save writes it. */
+void AnagramIndex::point_at(const char *data) {
+    AnagramHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    classes = reinterpret_cast<const ClassEntry *>(data + sizeof(header));
+    refs = reinterpret_cast<const std::uint32_t *>(classes + header.num_classes);
+    arena = reinterpret_cast<const char *>(refs + 2 * header.num_words);
+    classes_size = header.num_classes;
+    words_size = header.num_words;
+    largest = header.largest;
+}
+
+std::unique_ptr<AnagramIndex> AnagramIndex::read_words(const std::string &filename) {
+    MappedFile words(filename);
+    words.advise_sequential();
+    return std::unique_ptr<AnagramIndex>(new AnagramIndex(words.data(), words.size()));
+}
+
+std::unique_ptr<AnagramIndex> AnagramIndex::load_or_build(const std::string &filename,
+        const std::string &wordlist) {
+    try {
+        return std::unique_ptr<AnagramIndex>(new AnagramIndex(filename));
+    } catch (std::runtime_error &) {
+        read_words(wordlist)->save(filename);
+        return std::unique_ptr<AnagramIndex>(new AnagramIndex(filename));
+    }
+}
+
+void AnagramIndex::save(const std::string &filename) const {
+    const char *data = mapped ? mapped->data() : owned.data();
+    const std::size_t size = mapped ? mapped->size() : owned.size();
+
+    // Write beside the target then rename, a reader never maps half an index.
+    std::string temp = filename + ".tmp";
+    std::ofstream fout(temp.c_str(), std::ios::binary | std::ios::trunc);
+    fout.write(data, size);
+    fout.close();
+    if (!fout || std::rename(temp.c_str(), filename.c_str()) != 0) {
+        std::remove(temp.c_str());
+        throw std::runtime_error("Unable to write anagram index: " + filename);
+    }
+}
+
+AnagramClass AnagramIndex::anagrams(const std::string &word) const {
+    Signature sig;
+    if (!letter_signature(word.data(), word.size(), sig)) {
+        return AnagramClass();
+    }
+
+    const ClassEntry *last = classes + classes_size;
+    const ClassEntry *found = std::lower_bound(classes, last, sig,
+            [](const ClassEntry &entry, const Signature &sig) {
+        return entry.high < sig.high || (entry.high == sig.high && entry.low < sig.low);
+    });
+    if (found == last || found->low != sig.low || found->high != sig.high) {
+        return AnagramClass();
+    }
+
+    return get_class(found - classes);
+}
+
+AnagramClass AnagramIndex::largest_class() const {
+    return classes_size ? get_class(largest) : AnagramClass();
+}
+
+AnagramClass AnagramIndex::get_class(std::size_t index) const {
+    if (index >= classes_size) {
+        throw std::out_of_range("No anagram class at that index.");
+    }
+
+    AnagramClass result;
+    result.signature.low = classes[index].low;
+    result.signature.high = classes[index].high;
+    result.refs = refs + 2 * classes[index].first;
+    result.arena = arena;
+    result.count = classes[index].count;
+
+    return result;
+}
+
+} /* end util:: */
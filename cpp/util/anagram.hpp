@@ -0,0 +1,136 @@
+#ifndef _ANAGRAM_HPP_
+#define _ANAGRAM_HPP_
+
+/********************* Header Files ***********************/
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "mapped_file.hpp"
+
+namespace util {
+
+/******************* Constants/Macros *********************/
+static const int NUM_LETTERS = 26;
+// Bits per letter count in a Signature, no letter may repeat more than 15 times.
+static const int LETTER_BITS = 4;
+static const int LETTERS_PER_WORD = 64 / LETTER_BITS;
+static const std::uint32_t ANAGRAM_VERSION = 1;
+
+/************** Class & Func Declarations *****************/
+/*
+ * Count of each letter packed into fixed width integers.
+ * Words are anagrams exactly when their signatures are equal.
+ */
+class Signature {
+public:
+    bool operator==(const Signature &other) const {
+        return low == other.low && high == other.high;
+    }
+    bool operator!=(const Signature &other) const {
+        return !(*this == other);
+    }
+    bool operator<(const Signature &other) const {
+        return high < other.high || (high == other.high && low < other.low);
+    }
+    /* The letters in order, i.e. the signature of RACE prints ACER. */
+    friend std::ostream & operator<<(std::ostream &os, const Signature &sig);
+
+    // Data
+    // Letters A to P in low, Q to Z in high.
+    std::uint64_t low = 0;
+    std::uint64_t high = 0;
+};
+
+class SignatureHash {
+public:
+    std::size_t operator()(const Signature &sig) const {
+        return sig.low ^ (sig.high * 0xC2B2AE3D27D4EB4FULL);
+    }
+};
+
+/*
+ * Signature of the letters in word, either case, other bytes are ignored.
+ * False if there is no letter or one letter repeats more than 15 times.
+ */
+bool letter_signature(const char *word, std::size_t length, Signature &sig);
+
+/* Words sharing one signature, a view into the AnagramIndex that made it. */
+class AnagramClass {
+public:
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::string word(std::size_t index) const;
+    std::vector<std::string> words() const;
+
+    // Data
+    Signature signature;
+    const std::uint32_t *refs = NULL;
+    const char *arena = NULL;
+    std::size_t count = 0;
+};
+
+/*
+ * Anagram classes of a whole word list.
+ * The text of every word sits in one arena, each class lists its words
+ * contiguously & classes are sorted by signature, so a query is one binary
+ * search. Saved indexes are memory mapped and used in place.
+ */
+class AnagramIndex {
+public:
+    // Map a saved index, throws std::runtime_error if missing, truncated or from another version.
+    explicit AnagramIndex(const std::string &filename);
+    /*
+     * Index the words in text. Words are separated by whitespace, commas or
+     * double quotes, so plain lists & quoted CSV both read. Exact repeats are
+     * kept once, words letter_signature refuses are skipped.
+     */
+    AnagramIndex(const char *text, std::size_t size);
+    AnagramIndex(const AnagramIndex &other) = delete;
+    AnagramIndex & operator=(const AnagramIndex &other) = delete;
+
+    // Map the word list & index it, throws std::runtime_error if it can't be read.
+    static std::unique_ptr<AnagramIndex> read_words(const std::string &filename);
+    // Map filename if it holds a valid index, otherwise index wordlist, save & map it.
+    static std::unique_ptr<AnagramIndex> load_or_build(const std::string &filename,
+            const std::string &wordlist);
+    void save(const std::string &filename) const;
+
+    /* Every word that is an anagram of word, itself included if listed. */
+    AnagramClass anagrams(const std::string &word) const;
+    /* Class with the most words, lowest signature on a tie. */
+    AnagramClass largest_class() const;
+    /* Classes in signature order, index below num_classes(). */
+    AnagramClass get_class(std::size_t index) const;
+
+    std::size_t num_classes() const { return classes_size; }
+    std::size_t num_words() const { return words_size; }
+
+private:
+    class ClassEntry {
+    public:
+        std::uint64_t low;
+        std::uint64_t high;
+        // Index of the class's first word in refs & how many it has.
+        std::uint32_t first;
+        std::uint32_t count;
+    };
+
+    void point_at(const char *data);
+
+    std::unique_ptr<MappedFile> mapped;
+    std::vector<char> owned;
+    const ClassEntry *classes = NULL;
+    // Two per word: offset into the arena & length.
+    const std::uint32_t *refs = NULL;
+    const char *arena = NULL;
+    std::size_t classes_size = 0;
+    std::size_t words_size = 0;
+    std::size_t largest = 0;
+};
+
+} /* end util:: */
+
+#endif /* _ANAGRAM_HPP_ */
@@ -0,0 +1,134 @@
+/**
+ * Test cases for the anagram index
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+#include "gtest/gtest.h"
+#include "anagram.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+
+/************** Global Vars & Functions *******************/
+static const std::string ANAGRAM_FNAME = "/tmp/util_anagram_test.bin";
+static const std::string WORDS_FNAME = "/tmp/util_anagram_test.txt";
+
+TEST(UtilAnagram, LetterSignature) {
+    util::Signature race, acre, races;
+    ASSERT_TRUE(util::letter_signature("RACE", 4, race));
+    ASSERT_TRUE(util::letter_signature("acre", 4, acre));
+    ASSERT_TRUE(util::letter_signature("RACES", 5, races));
+    ASSERT_EQ(race, acre);
+    ASSERT_NE(race, races);
+
+    util::Signature sig;
+    ASSERT_TRUE(util::letter_signature("don't", 5, sig));
+    ASSERT_FALSE(util::letter_signature("1234", 4, sig));
+    ASSERT_FALSE(util::letter_signature("AAAAAAAAAAAAAAAA", 16, sig));
+    ASSERT_TRUE(util::letter_signature("AAAAAAAAAAAAAAA", 15, sig));
+
+    std::stringstream ss;
+    ss << race;
+    ASSERT_EQ(ss.str(), "ACER");
+}
+
+TEST(UtilAnagram, Queries) {
+    const std::string text = "\"CARE\",\"RACE\",\"DOG\",\"ACRE\",\"GOD\",\"CAT\",\"RACE\"\n";
+    util::AnagramIndex index(text.data(), text.size());
+    ASSERT_EQ(index.num_classes(), 3);
+    ASSERT_EQ(index.num_words(), 6);
+
+    std::vector<std::string> expect = {"ACRE", "CARE", "RACE"};
+    ASSERT_EQ(index.anagrams("ecar").words(), expect);
+    ASSERT_EQ(index.largest_class().words(), expect);
+    ASSERT_EQ(index.anagrams("ODG").size(), 2);
+    ASSERT_TRUE(index.anagrams("COW").empty());
+    ASSERT_TRUE(index.anagrams("").empty());
+    ASSERT_THROW(index.get_class(3), std::out_of_range);
+}
+
+TEST(UtilAnagram, PlainList) {
+    std::ofstream(WORDS_FNAME) << "listen\r\nsilent\nenlist\ttinsel\n\ngoogle\n";
+    std::unique_ptr<util::AnagramIndex> index = util::AnagramIndex::read_words(WORDS_FNAME);
+    ASSERT_EQ(index->num_classes(), 2);
+    ASSERT_EQ(index->largest_class().size(), 4);
+    ASSERT_EQ(index->anagrams("inlets").word(0), "enlist");
+    std::remove(WORDS_FNAME.c_str());
+}
+
+TEST(UtilAnagram, SaveAndMap) {
+    std::ofstream(WORDS_FNAME) << "\"STOP\",\"POST\",\"SPOT\",\"OPTS\",\"TOPS\",\"EAT\",\"TEA\"";
+    std::remove(ANAGRAM_FNAME.c_str());
+    std::unique_ptr<util::AnagramIndex> built =
+        util::AnagramIndex::load_or_build(ANAGRAM_FNAME, WORDS_FNAME);
+    std::remove(WORDS_FNAME.c_str());
+
+    // The word list is gone, so this can only come from the saved index.
+    std::unique_ptr<util::AnagramIndex> mapped =
+        util::AnagramIndex::load_or_build(ANAGRAM_FNAME, WORDS_FNAME);
+    ASSERT_EQ(mapped->num_classes(), built->num_classes());
+    ASSERT_EQ(mapped->num_words(), 7);
+    ASSERT_EQ(mapped->largest_class().words(), built->largest_class().words());
+    ASSERT_EQ(mapped->anagrams("ate").words(), std::vector<std::string>({"EAT", "TEA"}));
+    std::remove(ANAGRAM_FNAME.c_str());
+}
+
+TEST(UtilAnagram, RejectsStaleFile) {
+    std::ofstream(ANAGRAM_FNAME) << "not an index";
+    ASSERT_THROW(util::AnagramIndex index(ANAGRAM_FNAME), std::runtime_error);
+    std::remove(ANAGRAM_FNAME.c_str());
+}
+
+TEST(UtilAnagram, RejectsCorruptFile) {
+    std::ofstream(WORDS_FNAME) << "\"STOP\",\"POST\",\"SPOT\",\"OPTS\",\"TOPS\",\"EAT\",\"TEA\"";
+    std::remove(ANAGRAM_FNAME.c_str());
+    util::AnagramIndex::load_or_build(ANAGRAM_FNAME, WORDS_FNAME);
+    std::remove(WORDS_FNAME.c_str());
+
+    // Saved as a 40 byte header, 24 byte classes ending in first & count, then word refs.
+    const std::uint32_t too_far = 1000;
+    const std::streamoff first_count = 40 + 20, first_ref = 40 + 2 * 24;
+    for (std::streamoff offset : {first_count, first_ref}) {
+        std::string saved;
+        {
+            std::ifstream fin(ANAGRAM_FNAME, std::ios::binary);
+            saved.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+        }
+        std::string corrupt = saved;
+        std::memcpy(&corrupt[offset], &too_far, sizeof(too_far));
+        std::ofstream(ANAGRAM_FNAME, std::ios::binary) << corrupt;
+        ASSERT_THROW(util::AnagramIndex index(ANAGRAM_FNAME), std::runtime_error);
+        std::ofstream(ANAGRAM_FNAME, std::ios::binary) << saved;
+        ASSERT_NO_THROW(util::AnagramIndex index(ANAGRAM_FNAME));
+    }
+    std::remove(ANAGRAM_FNAME.c_str());
+}
+
+TEST(UtilAnagram, LargeList) {
+    // Every arrangement of 8 distinct letters plus a spread of other classes.
+    std::string text;
+    std::string letters = "ABCDEFGH";
+    do {
+        text += letters + '\n';
+    } while (std::next_permutation(letters.begin(), letters.end()));
+    for (int i = 0; i < 100000; ++i) {
+        text += std::string(1, 'A' + i % 26) + std::string(1, 'A' + i / 26 % 26) +
+            std::string(1, 'A' + i / 676 % 26) + "Z\n";
+    }
+
+    util::AnagramIndex index(text.data(), text.size());
+    ASSERT_EQ(index.num_words(), 40320 + 17576);
+    ASSERT_EQ(index.anagrams("HGFEDCBA").size(), 40320);
+    ASSERT_EQ(index.largest_class().size(), 40320);
+}
@@ -0,0 +1,248 @@
+/**
+ * Exact hold/discard outcomes for five card draw.
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include "draw.hpp"
+#include "equity.hpp"
+
+namespace util {
+
+namespace poker {
+
+/***************** Constants & Macros *********************/
+static const int UNSEEN_CARDS = NUM_CARDS - DRAW_HAND_SIZE;
+static const std::uint32_t ALL_RANKS = (1u << NUM_RANKS) - 1;
+
+/************** Global Vars & Functions *******************/
+double DrawOption::expected(const std::vector<double> &payouts) const {
+    if (payouts.size() != static_cast<std::size_t>(NUM_CATEGORIES)) {
+        throw std::invalid_argument("Need one payout per hand category.");
+    }
+
+    double total = 0.0;
+    for (int cat = 0; cat < NUM_CATEGORIES; ++cat) {
+        total += payouts[cat] * categories[cat];
+    }
+
+    return total / draws;
+}
+
+/* Category of five cards known only by rank counts, assuming no flush. */
+Category rank_category(const int *counts) {
+    int pairs = 0, trips = 0;
+    std::uint32_t mask = 0;
+    for (int rank = 0; rank < NUM_RANKS; ++rank) {
+        if (counts[rank] == 4) {
+            return FourKind;
+        } else if (counts[rank] == 3) {
+            ++trips;
+        } else if (counts[rank] == 2) {
+            ++pairs;
+        } else if (counts[rank] == 1) {
+            mask |= 1u << rank;
+        }
+    }
+
+    if (trips) {
+        return pairs ? FullHouse : ThreeKind;
+    } else if (pairs) {
+        return pairs == 2 ? TwoPair : OnePair;
+    }
+
+    return straight_high(mask) == -1 ? HighCard : Straight;
+}
+
+/*
+ * Walk every way to draw left more cards by rank, ways multiplies the choice
+ * of suits at each rank. Each rank pattern is evaluated once whatever its suits.
+ */
+void count_ranks(int rank, int left, std::uint64_t ways, int *counts, const int *unseen,
+        DrawOption &option) {
+    if (left == 0) {
+        option.categories[rank_category(counts)] += ways;
+        return;
+    } else if (rank == NUM_RANKS) {
+        return;
+    }
+
+    for (int take = 0; take <= std::min(left, unseen[rank]); ++take) {
+        counts[rank] += take;
+        count_ranks(rank + 1, left - take, ways * choose(unseen[rank], take), counts, unseen, option);
+        counts[rank] -= take;
+    }
+}
+
+DrawOption draw_option(const std::vector<card_t> &hand, unsigned hold) {
+    DrawOption option;
+    option.hold = hold;
+    const int left = DRAW_HAND_SIZE - __builtin_popcount(hold);
+    option.draws = choose(UNSEEN_CARDS, left);
+
+    int counts[NUM_RANKS] = {0};
+    int unseen[NUM_RANKS];
+    std::fill(unseen, unseen + NUM_RANKS, NUM_SUITS);
+    std::uint32_t suit_ranks[NUM_SUITS] = {0, 0, 0, 0};
+    for (int i = 0; i < DRAW_HAND_SIZE; ++i) {
+        --unseen[card_rank(hand[i])];
+        suit_ranks[card_suit(hand[i])] |= 1u << card_rank(hand[i]);
+        if (hold & (1u << i)) {
+            ++counts[card_rank(hand[i])];
+        }
+    }
+    count_ranks(0, left, 1, counts, unseen, option);
+
+    // Ranks alone miss flushes: where every held card shares a suit, move each
+    // all suited draw from its straight or high card count to the flush it makes.
+    for (int suit = 0; suit < NUM_SUITS; ++suit) {
+        std::uint32_t held = 0;
+        bool suited = true;
+        for (int i = 0; i < DRAW_HAND_SIZE; ++i) {
+            if (hold & (1u << i)) {
+                suited = suited && card_suit(hand[i]) == suit;
+                held |= 1u << card_rank(hand[i]);
+            }
+        }
+        if (!suited) {
+            continue;
+        }
+
+        const std::uint32_t free = ALL_RANKS & ~suit_ranks[suit];
+        for (std::uint32_t drawn = 0; drawn <= ALL_RANKS; ++drawn) {
+            if ((drawn & ~free) || __builtin_popcount(drawn) != left) {
+                continue;
+            }
+
+            int high = straight_high(held | drawn);
+            --option.categories[high == -1 ? HighCard : Straight];
+            if (high == -1) {
+                ++option.categories[Flush];
+            } else {
+                ++option.categories[high == NUM_RANKS - 1 ? RoyalFlush : StraightFlush];
+            }
+        }
+    }
+
+    return option;
+}
+
+std::vector<DrawOption> draw_options(const std::vector<card_t> &hand, unsigned threads) {
+    std::uint64_t seen = 0;
+    for (card_t card : hand) {
+        if (card >= NUM_CARDS || (seen & (1ull << card))) {
+            throw std::invalid_argument("Draw needs 5 distinct cards.");
+        }
+        seen |= 1ull << card;
+    }
+    if (hand.size() != static_cast<std::size_t>(DRAW_HAND_SIZE)) {
+        throw std::invalid_argument("Draw needs 5 distinct cards.");
+    }
+
+    std::vector<DrawOption> options(NUM_HOLDS);
+    threads = threads ? threads : std::thread::hardware_concurrency();
+    threads = std::max(1u, std::min<unsigned>(threads, NUM_HOLDS));
+    std::atomic<unsigned> next_hold(0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&hand, &next_hold, &options]() {
+            unsigned hold;
+            while ((hold = next_hold.fetch_add(1)) < static_cast<unsigned>(NUM_HOLDS)) {
+                options[hold] = draw_option(hand, hold);
+            }
+        }));
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    return options;
+}
+
+unsigned best_hold(const std::vector<DrawOption> &options, const std::vector<double> &payouts) {
+    unsigned best = 0;
+    double best_value = 0.0;
+    for (std::size_t i = 0; i < options.size(); ++i) {
+        double value = options[i].expected(payouts);
+        if (i == 0 || value > best_value) {
+            best = options[i].hold;
+            best_value = value;
+        }
+    }
+
+    return best;
+}
+
+std::vector<DrawOption> DrawSolver::solve(const std::vector<card_t> &hand) {
+    if (hand.size() != static_cast<std::size_t>(DRAW_HAND_SIZE)) {
+        throw std::invalid_argument("Draw needs 5 distinct cards.");
+    }
+
+    // Canonical hand is the smallest sorted relabeling over every suit permutation.
+    int perm[NUM_SUITS] = {0, 1, 2, 3}, best_perm[NUM_SUITS] = {0, 1, 2, 3};
+    std::vector<card_t> canon, mapped(DRAW_HAND_SIZE);
+    std::uint32_t key = 0;
+    do {
+        for (int i = 0; i < DRAW_HAND_SIZE; ++i) {
+            mapped[i] = make_card(card_rank(hand[i]), perm[card_suit(hand[i])]);
+        }
+        std::sort(mapped.begin(), mapped.end());
+        std::uint32_t packed = 0;
+        for (card_t card : mapped) {
+            packed = (packed << 6) | card;
+        }
+        if (canon.empty() || packed < key) {
+            canon = mapped;
+            key = packed;
+            std::copy(perm, perm + NUM_SUITS, best_perm);
+        }
+    } while (std::next_permutation(perm, perm + NUM_SUITS));
+
+    std::vector<DrawOption> canon_options;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto found = cache.find(key);
+        if (found != cache.end()) {
+            canon_options = found->second;
+        }
+    }
+    if (canon_options.empty()) {
+        canon_options = draw_options(canon, threads);
+        std::lock_guard<std::mutex> guard(lock);
+        cache.emplace(key, canon_options);
+    }
+
+    // Position of each of the hand's cards within the canonical hand.
+    int position[DRAW_HAND_SIZE];
+    for (int i = 0; i < DRAW_HAND_SIZE; ++i) {
+        card_t card = make_card(card_rank(hand[i]), best_perm[card_suit(hand[i])]);
+        position[i] = std::find(canon.begin(), canon.end(), card) - canon.begin();
+    }
+
+    std::vector<DrawOption> options(NUM_HOLDS);
+    for (unsigned hold = 0; hold < static_cast<unsigned>(NUM_HOLDS); ++hold) {
+        unsigned canon_hold = 0;
+        for (int i = 0; i < DRAW_HAND_SIZE; ++i) {
+            if (hold & (1u << i)) {
+                canon_hold |= 1u << position[i];
+            }
+        }
+        options[hold] = canon_options[canon_hold];
+        options[hold].hold = hold;
+    }
+
+    return options;
+}
+
+std::size_t DrawSolver::cached() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return cache.size();
+}
+
+} /* end util::poker */
+
+} /* end util:: */
@@ -0,0 +1,69 @@
+#ifndef _DRAW_HPP_
+#define _DRAW_HPP_
+
+/********************* Header Files ***********************/
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "poker.hpp"
+
+namespace util {
+
+namespace poker {
+
+/******************* Constants/Macros *********************/
+static const int DRAW_HAND_SIZE = 5;
+// Every subset of the hand may be held, the bit for card i is 1 << i.
+static const int NUM_HOLDS = 1 << DRAW_HAND_SIZE;
+
+/************** Class & Func Declarations *****************/
+// Exact outcome of holding some cards & drawing the rest from the 47 unseen.
+class DrawOption {
+public:
+    double probability(Category cat) const {
+        return static_cast<double>(categories[cat]) / draws;
+    }
+    /* Expected payout, payouts holds one value per Category. */
+    double expected(const std::vector<double> &payouts) const;
+
+    // Data
+    unsigned hold = 0;
+    std::uint64_t draws = 0;
+    // Final hands of each Category over all draws.
+    std::uint64_t categories[NUM_CATEGORIES] = {0};
+};
+
+/*
+ * All NUM_HOLDS options for a five card hand, indexed by hold mask.
+ * Draws are counted by rank pattern with flushes settled per suit, so no
+ * branch enumerates single draws. Branches run on threads, 0 uses all hardware threads.
+ * Throws std::invalid_argument unless given 5 distinct cards.
+ */
+std::vector<DrawOption> draw_options(const std::vector<card_t> &hand, unsigned threads = 0);
+/* Hold mask with the highest expected payout, lowest mask on a tie. */
+unsigned best_hold(const std::vector<DrawOption> &options, const std::vector<double> &payouts);
+
+/*
+ * draw_options behind a cache keyed by the hand's suit isomorphic class.
+ * Hands equal up to relabeling suits share one entry. Safe to share between threads.
+ */
+class DrawSolver {
+public:
+    explicit DrawSolver(unsigned threads = 0) : threads(threads) {}
+    std::vector<DrawOption> solve(const std::vector<card_t> &hand);
+    std::size_t cached() const;
+
+private:
+    unsigned threads;
+    mutable std::mutex lock;
+    // Options in the order of the canonical hand's sorted cards.
+    std::unordered_map<std::uint32_t, std::vector<DrawOption> > cache;
+};
+
+} /* end util::poker */
+
+} /* end util:: */
+
+#endif /* _DRAW_HPP_ */
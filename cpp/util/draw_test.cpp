@@ -0,0 +1,140 @@
+/**
+ * Test cases for the five card draw solver
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <algorithm>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "draw.hpp"
+#include "equity.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+namespace poker = util::poker;
+
+/************** Global Vars & Functions *******************/
+/* Deal every draw one by one, the slow way. */
+poker::DrawOption brute_draw(const std::vector<poker::card_t> &hand, unsigned hold) {
+    poker::DrawOption option;
+    option.hold = hold;
+    std::vector<poker::card_t> deck, kept;
+    for (int card = 0; card < poker::NUM_CARDS; ++card) {
+        if (std::find(hand.begin(), hand.end(), card) == hand.end()) {
+            deck.push_back(card);
+        }
+    }
+    for (int i = 0; i < poker::DRAW_HAND_SIZE; ++i) {
+        if (hold & (1u << i)) {
+            kept.push_back(hand[i]);
+        }
+    }
+
+    const std::size_t left = poker::DRAW_HAND_SIZE - kept.size();
+    std::vector<bool> pick(deck.size(), false);
+    std::fill(pick.begin(), pick.begin() + left, true);
+    do {
+        std::vector<poker::card_t> final = kept;
+        for (std::size_t i = 0; i < deck.size(); ++i) {
+            if (pick[i]) {
+                final.push_back(deck[i]);
+            }
+        }
+        ++option.categories[poker::category(poker::evaluate(final))];
+        ++option.draws;
+    } while (std::prev_permutation(pick.begin(), pick.end()));
+
+    return option;
+}
+
+TEST(UtilDraw, FourFlush) {
+    // Hold the four hearts: 9 flush outs, 12 pairing outs.
+    std::vector<poker::DrawOption> options = poker::draw_options(poker::parse_cards("2H 5H 9H JH KS"));
+    ASSERT_EQ(options.size(), poker::NUM_HOLDS);
+    const poker::DrawOption &hearts = options[0xF];
+    ASSERT_EQ(hearts.hold, 0xF);
+    ASSERT_EQ(hearts.draws, 47);
+    ASSERT_EQ(hearts.categories[poker::Flush], 9);
+    ASSERT_EQ(hearts.categories[poker::OnePair], 12);
+    ASSERT_EQ(hearts.categories[poker::HighCard], 26);
+    ASSERT_DOUBLE_EQ(hearts.probability(poker::Flush), 9.0 / 47);
+
+    const poker::DrawOption &pat = options[0x1F];
+    ASSERT_EQ(pat.draws, 1);
+    ASSERT_EQ(pat.categories[poker::HighCard], 1);
+}
+
+TEST(UtilDraw, MatchesBruteForce) {
+    // Straight flush & royal draws on top of pairs, so every correction is exercised.
+    std::vector<poker::card_t> hand = poker::parse_cards("TH JH QH KH KS");
+    std::vector<poker::DrawOption> options = poker::draw_options(hand, 2);
+    std::uint64_t total = 0;
+    for (unsigned hold = 0; hold < poker::NUM_HOLDS; ++hold) {
+        const int left = poker::DRAW_HAND_SIZE - __builtin_popcount(hold);
+        ASSERT_EQ(options[hold].draws, poker::choose(47, left));
+        std::uint64_t sum = 0;
+        for (std::uint64_t count : options[hold].categories) {
+            sum += count;
+        }
+        ASSERT_EQ(sum, options[hold].draws);
+        total += sum;
+
+        if (left > 3) {
+            continue;
+        }
+        poker::DrawOption brute = brute_draw(hand, hold);
+        for (int cat = 0; cat < poker::NUM_CATEGORIES; ++cat) {
+            ASSERT_EQ(options[hold].categories[cat], brute.categories[cat]) << hold << " " << cat;
+        }
+    }
+    // Summed over every hold, draws from 47 count each 5 card hand of the 52 once.
+    ASSERT_EQ(total, poker::choose(52, 5));
+}
+
+TEST(UtilDraw, BestHold) {
+    std::vector<double> royal_only(poker::NUM_CATEGORIES, 0.0);
+    royal_only[poker::RoyalFlush] = 1.0;
+    std::vector<poker::DrawOption> options = poker::draw_options(poker::parse_cards("TH JH QH KH KS"));
+    ASSERT_EQ(poker::best_hold(options, royal_only), 0xF);
+    ASSERT_DOUBLE_EQ(options[0xF].expected(royal_only), 1.0 / 47);
+
+    std::vector<double> quads_only(poker::NUM_CATEGORIES, 0.0);
+    quads_only[poker::FourKind] = 1.0;
+    ASSERT_EQ(poker::best_hold(options, quads_only), 0x18);
+    ASSERT_THROW(options[0].expected(std::vector<double>(3)), std::invalid_argument);
+}
+
+TEST(UtilDraw, SolverCachesSuitClass) {
+    poker::DrawSolver solver(2);
+    std::vector<poker::DrawOption> first = solver.solve(poker::parse_cards("2H 5H 9H JH KS"));
+    std::vector<poker::DrawOption> second = solver.solve(poker::parse_cards("KD JS 9S 5S 2S"));
+    ASSERT_EQ(solver.cached(), 1);
+
+    // Second hand lists the same cards in reverse, hold masks follow the given order.
+    for (unsigned hold = 0; hold < poker::NUM_HOLDS; ++hold) {
+        unsigned reversed = 0;
+        for (int i = 0; i < poker::DRAW_HAND_SIZE; ++i) {
+            if (hold & (1u << i)) {
+                reversed |= 1u << (poker::DRAW_HAND_SIZE - 1 - i);
+            }
+        }
+        ASSERT_EQ(second[reversed].hold, reversed);
+        for (int cat = 0; cat < poker::NUM_CATEGORIES; ++cat) {
+            ASSERT_EQ(second[reversed].categories[cat], first[hold].categories[cat]);
+        }
+    }
+    ASSERT_EQ(second[0x1E].categories[poker::Flush], 9);
+
+    solver.solve(poker::parse_cards("2C 5H 9H JH KS"));
+    ASSERT_EQ(solver.cached(), 2);
+}
+
+TEST(UtilDraw, InvalidHand) {
+    ASSERT_THROW(poker::draw_options(poker::parse_cards("2H 5H 9H JH")), std::invalid_argument);
+    ASSERT_THROW(poker::draw_options(poker::parse_cards("2H 5H 9H JH 2H")), std::invalid_argument);
+    poker::DrawSolver solver;
+    ASSERT_THROW(solver.solve(poker::parse_cards("2H 5H")), std::invalid_argument);
+}
@@ -0,0 +1,402 @@
+/**
+ * Equity of known hole cards against a partial board.
+ * Small board spaces are enumerated exactly, large ones are sampled.
+ * Either way work is spread over threads, each keeping a private tally.
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+#include "equity.hpp"
+
+namespace util {
+
+namespace poker {
+
+/***************** Constants & Macros *********************/
+// Divisible by every pot split up to MAX_PLAYERS, keeps shares integral.
+static const std::uint64_t SHARE_UNIT = 2520;
+// Boards a sampling thread runs before publishing its tally.
+static const std::uint64_t SAMPLE_BATCH = 4096;
+
+/****************** Class Definitions *********************/
+namespace {
+
+// Per thread counts, only merged once a thread is done with them.
+class Tally {
+public:
+    void add(const Tally &other, int players) {
+        boards += other.boards;
+        for (int i = 0; i < players; ++i) {
+            wins[i] += other.wins[i];
+            ties[i] += other.ties[i];
+            share[i] += other.share[i];
+            share_sq[i] += other.share_sq[i];
+        }
+    }
+
+    // Data
+    std::uint64_t boards = 0;
+    std::uint64_t wins[MAX_PLAYERS] = {0};
+    std::uint64_t ties[MAX_PLAYERS] = {0};
+    std::uint64_t share[MAX_PLAYERS] = {0};
+    std::uint64_t share_sq[MAX_PLAYERS] = {0};
+};
+
+// Running totals sampling threads publish into without a lock.
+class SharedTally {
+public:
+    explicit SharedTally(int players) : players(players) {
+        boards.store(0);
+        for (int i = 0; i < MAX_PLAYERS; ++i) {
+            wins[i].store(0);
+            ties[i].store(0);
+            share[i].store(0);
+            share_sq[i].store(0);
+        }
+    }
+
+    void add(const Tally &tally) {
+        for (int i = 0; i < players; ++i) {
+            wins[i].fetch_add(tally.wins[i], std::memory_order_relaxed);
+            ties[i].fetch_add(tally.ties[i], std::memory_order_relaxed);
+            share[i].fetch_add(tally.share[i], std::memory_order_relaxed);
+            share_sq[i].fetch_add(tally.share_sq[i], std::memory_order_relaxed);
+        }
+        boards.fetch_add(tally.boards, std::memory_order_release);
+    }
+
+    Tally snapshot() const {
+        Tally tally;
+        tally.boards = boards.load(std::memory_order_acquire);
+        for (int i = 0; i < players; ++i) {
+            tally.wins[i] = wins[i].load(std::memory_order_relaxed);
+            tally.ties[i] = ties[i].load(std::memory_order_relaxed);
+            tally.share[i] = share[i].load(std::memory_order_relaxed);
+            tally.share_sq[i] = share_sq[i].load(std::memory_order_relaxed);
+        }
+
+        return tally;
+    }
+
+    // Data
+    const int players;
+    std::atomic<std::uint64_t> boards;
+    std::atomic<std::uint64_t> wins[MAX_PLAYERS];
+    std::atomic<std::uint64_t> ties[MAX_PLAYERS];
+    std::atomic<std::uint64_t> share[MAX_PLAYERS];
+    std::atomic<std::uint64_t> share_sq[MAX_PLAYERS];
+};
+
+} /* end anonymous */
+
+/************** Global Vars & Functions *******************/
+std::uint64_t choose(std::uint64_t n, std::uint64_t k) {
+    if (k > n) {
+        return 0;
+    }
+    k = std::min(k, n - k);
+
+    std::uint64_t result = 1;
+    for (std::uint64_t i = 1; i <= k; ++i) {
+        if (result > std::numeric_limits<std::uint64_t>::max() / n) {
+            return std::numeric_limits<std::uint64_t>::max();
+        }
+        // Exact at every step, product of i consecutive ints divides by i!
+        result = result * (n - k + i) / i;
+    }
+
+    return result;
+}
+
+namespace {
+
+/* Settle one board among all players, strength of player i is strengths[i * stride]. */
+inline void settle(const strength_t *strengths, std::size_t stride, int players, Tally &tally) {
+    strength_t best = 0;
+    int winners = 0;
+    for (int i = 0; i < players; ++i) {
+        if (strengths[i * stride] > best) {
+            best = strengths[i * stride];
+            winners = 1;
+        } else if (strengths[i * stride] == best) {
+            ++winners;
+        }
+    }
+
+    const std::uint64_t share = SHARE_UNIT / winners;
+    for (int i = 0; i < players; ++i) {
+        if (strengths[i * stride] == best) {
+            if (winners == 1) {
+                ++tally.wins[i];
+            } else {
+                ++tally.ties[i];
+            }
+            tally.share[i] += share;
+            tally.share_sq[i] += share * share;
+        }
+    }
+    ++tally.boards;
+}
+
+// Complete boards waiting to be settled. Every player's hand on every board is
+// evaluated as one struct of arrays batch, card j of player p on board b at
+// cards[j * hands + p * size + b] where hands is players * size.
+class BoardBatch {
+public:
+    explicit BoardBatch(const std::vector<hole_t> &holes) : holes(holes) {}
+
+    void add(const card_t *board, Tally &tally) {
+        std::copy(board, board + BOARD_SIZE, boards[size]);
+        if (++size == BATCH_SIZE) {
+            settle_all(tally);
+        }
+    }
+
+    void settle_all(Tally &tally) {
+        if (size == 0) {
+            return;
+        }
+
+        const int players = holes.size();
+        const std::size_t hands = players * size;
+        for (int p = 0; p < players; ++p) {
+            for (int b = 0; b < size; ++b) {
+                card_t *lane = cards + p * size + b;
+                lane[0] = holes[p][0];
+                lane[hands] = holes[p][1];
+                for (int j = 0; j < BOARD_SIZE; ++j) {
+                    lane[(2 + j) * hands] = boards[b][j];
+                }
+            }
+        }
+
+        evaluate_batch(cards, 2 + BOARD_SIZE, hands, strengths);
+        for (int b = 0; b < size; ++b) {
+            settle(strengths + b, size, players, tally);
+        }
+        size = 0;
+    }
+
+private:
+    const std::vector<hole_t> &holes;
+    card_t boards[BATCH_SIZE][BOARD_SIZE];
+    card_t cards[(2 + BOARD_SIZE) * MAX_PLAYERS * BATCH_SIZE];
+    strength_t strengths[MAX_PLAYERS * BATCH_SIZE];
+    int size = 0;
+};
+
+/* Standard error of the mean equity of one player. */
+inline double std_error(const Tally &tally, int player) {
+    if (tally.boards == 0) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    const double n = tally.boards;
+    const double mean = tally.share[player] / (n * SHARE_UNIT);
+    const double mean_sq = tally.share_sq[player] / (n * SHARE_UNIT * SHARE_UNIT);
+    return std::sqrt(std::max(0.0, mean_sq - mean * mean) / n);
+}
+
+/*
+ * Exact enumeration, threads claim the lowest deck index of each combination.
+ * The k - 1 other cards are walked in lexicographic order above it.
+ */
+void enumerate_worker(const std::vector<hole_t> &holes, const std::vector<card_t> &board,
+        const std::vector<card_t> &deck, int need, std::atomic<int> &next_first, Tally &tally) {
+    const int deck_size = deck.size();
+    const int known = board.size();
+    const int rest = need - 1;
+    card_t full[BOARD_SIZE];
+    std::copy(board.begin(), board.end(), full);
+    BoardBatch batch(holes);
+
+    int first;
+    while ((first = next_first.fetch_add(1)) <= deck_size - need) {
+        full[known] = deck[first];
+
+        int inds[BOARD_SIZE];
+        for (int j = 0; j < rest; ++j) {
+            inds[j] = first + 1 + j;
+        }
+
+        while (true) {
+            for (int j = 0; j < rest; ++j) {
+                full[known + 1 + j] = deck[inds[j]];
+            }
+            batch.add(full, tally);
+
+            int j = rest - 1;
+            while (j >= 0 && inds[j] == deck_size - rest + j) {
+                --j;
+            }
+            if (j < 0) {
+                break;
+            }
+            ++inds[j];
+            for (int l = j + 1; l < rest; ++l) {
+                inds[l] = inds[l - 1] + 1;
+            }
+        }
+    }
+    batch.settle_all(tally);
+}
+
+/*
+ * Monte Carlo sampling with a private RNG stream per thread.
+ * Boards are claimed in batches so the total never passes max_samples.
+ */
+void sample_worker(const std::vector<hole_t> &holes, const std::vector<card_t> &board,
+        std::vector<card_t> deck, int need, const EquityConfig &config, unsigned stream,
+        std::atomic<std::uint64_t> &claimed, std::atomic<bool> &done, SharedTally &shared) {
+    const int players = holes.size();
+    const int deck_size = deck.size();
+    const int known = board.size();
+    std::seed_seq seq = {static_cast<std::uint32_t>(config.seed),
+        static_cast<std::uint32_t>(config.seed >> 32), stream};
+    std::mt19937_64 rng(seq);
+
+    card_t full[BOARD_SIZE];
+    std::copy(board.begin(), board.end(), full);
+    BoardBatch boards(holes);
+
+    while (!done.load(std::memory_order_relaxed)) {
+        std::uint64_t start = claimed.fetch_add(SAMPLE_BATCH);
+        if (start >= config.max_samples) {
+            break;
+        }
+        std::uint64_t batch = std::min(SAMPLE_BATCH, config.max_samples - start);
+
+        Tally tally;
+        for (std::uint64_t b = 0; b < batch; ++b) {
+            // Partial Fisher-Yates, only the first need slots are shuffled.
+            for (int i = 0; i < need; ++i) {
+                std::uniform_int_distribution<int> pick(i, deck_size - 1);
+                std::swap(deck[i], deck[pick(rng)]);
+                full[known + i] = deck[i];
+            }
+            boards.add(full, tally);
+        }
+        boards.settle_all(tally);
+        shared.add(tally);
+
+        if (config.target_error > 0.0) {
+            Tally total = shared.snapshot();
+            double worst = 0.0;
+            for (int i = 0; i < players; ++i) {
+                worst = std::max(worst, std_error(total, i));
+            }
+            if (total.boards >= SAMPLE_BATCH && worst <= config.target_error) {
+                done.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+EquityResult make_result(const Tally &tally, int players, bool exact) {
+    EquityResult result;
+    result.boards = tally.boards;
+    result.exact = exact;
+
+    const double n = tally.boards;
+    for (int i = 0; i < players; ++i) {
+        result.win.push_back(tally.wins[i] / n);
+        result.tie.push_back(tally.ties[i] / n);
+        result.loss.push_back((tally.boards - tally.wins[i] - tally.ties[i]) / n);
+        result.equity.push_back(tally.share[i] / (n * SHARE_UNIT));
+        result.std_error.push_back(exact ? 0.0 : std_error(tally, i));
+    }
+
+    return result;
+}
+
+} /* end anonymous */
+
+EquityResult calc_equity(const std::vector<hole_t> &holes, const std::vector<card_t> &board,
+        const EquityConfig &config) {
+    const int players = holes.size();
+    if (players < MIN_PLAYERS || players > MAX_PLAYERS) {
+        throw std::invalid_argument("Equity needs 2 to 10 players.");
+    }
+    if (board.size() > BOARD_SIZE) {
+        throw std::invalid_argument("Board can have at most 5 cards.");
+    }
+    if (config.max_samples == 0) {
+        throw std::invalid_argument("Sampling needs max_samples above 0.");
+    }
+
+    std::uint64_t used = 0;
+    std::vector<card_t> known(board);
+    for (const hole_t &hole : holes) {
+        known.insert(known.end(), hole.begin(), hole.end());
+    }
+    for (card_t card : known) {
+        if (card >= NUM_CARDS || (used & (1ULL << card))) {
+            throw std::invalid_argument("Invalid or repeated card: " + std::to_string(card));
+        }
+        used |= 1ULL << card;
+    }
+
+    std::vector<card_t> deck;
+    for (int card = 0; card < NUM_CARDS; ++card) {
+        if (!(used & (1ULL << card))) {
+            deck.push_back(card);
+        }
+    }
+
+    const int need = BOARD_SIZE - board.size();
+    const std::uint64_t combos = choose(deck.size(), need);
+    unsigned threads = config.threads ? config.threads : std::thread::hardware_concurrency();
+    threads = std::max(1u, threads);
+
+    if (need == 0) {
+        Tally tally;
+        BoardBatch batch(holes);
+        batch.add(board.data(), tally);
+        batch.settle_all(tally);
+        return make_result(tally, players, true);
+    }
+
+    if (combos <= config.exact_limit) {
+        threads = std::min<unsigned>(threads, deck.size() - need + 1);
+        std::vector<Tally> tallies(threads);
+        std::vector<std::thread> workers;
+        std::atomic<int> next_first(0);
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.push_back(std::thread(enumerate_worker, std::cref(holes), std::cref(board),
+                        std::cref(deck), need, std::ref(next_first), std::ref(tallies[t])));
+        }
+
+        Tally total;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers[t].join();
+            total.add(tallies[t], players);
+        }
+
+        return make_result(total, players, true);
+    }
+
+    SharedTally shared(players);
+    std::atomic<std::uint64_t> claimed(0);
+    std::atomic<bool> done(false);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.push_back(std::thread(sample_worker, std::cref(holes), std::cref(board), deck,
+                    need, std::cref(config), t, std::ref(claimed), std::ref(done), std::ref(shared)));
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    return make_result(shared.snapshot(), players, false);
+}
+
+} /* end util::poker */
+
+} /* end util:: */
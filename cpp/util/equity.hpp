@@ -0,0 +1,65 @@
+#ifndef _EQUITY_HPP_
+#define _EQUITY_HPP_
+
+/********************* Header Files ***********************/
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "poker.hpp"
+
+namespace util {
+
+namespace poker {
+
+/******************* Type Definitions *********************/
+typedef std::array<card_t, 2> hole_t;
+
+/******************* Constants/Macros *********************/
+static const int MIN_PLAYERS = 2;
+static const int MAX_PLAYERS = 10;
+static const int BOARD_SIZE = 5;
+
+/************** Class & Func Declarations *****************/
+class EquityConfig {
+public:
+    // Worker threads, 0 uses all hardware threads.
+    unsigned threads = 0;
+    // Enumerate every board when there are at most this many, otherwise sample.
+    std::uint64_t exact_limit = 2000000;
+    // Hard cap on sampled boards.
+    std::uint64_t max_samples = 10000000;
+    // Stop sampling once every player's equity standard error is at or below this, 0 disables.
+    double target_error = 0.0;
+    std::uint64_t seed = 5489;
+};
+
+// All values are per player, in the order the hole cards were given.
+// equity counts a split pot as the player's share, win & tie are exclusive.
+class EquityResult {
+public:
+    std::vector<double> win;
+    std::vector<double> tie;
+    std::vector<double> loss;
+    std::vector<double> equity;
+    std::vector<double> std_error;
+    std::uint64_t boards = 0;
+    bool exact = false;
+};
+
+/* Number of ways to choose k of n, saturates at UINT64_MAX. */
+std::uint64_t choose(std::uint64_t n, std::uint64_t k);
+
+/*
+ * Compute win/tie/loss for 2 to 10 players against a board of 0 to 5 known cards.
+ * Throws std::invalid_argument on a bad player count, board size, repeated card or no max_samples.
+ */
+EquityResult calc_equity(const std::vector<hole_t> &holes,
+        const std::vector<card_t> &board = std::vector<card_t>(),
+        const EquityConfig &config = EquityConfig());
+
+} /* end util::poker */
+
+} /* end util:: */
+
+#endif /* _EQUITY_HPP_ */
@@ -0,0 +1,124 @@
+/**
+ * Test cases for the equity calculator
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "equity.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+namespace poker = util::poker;
+using poker::hole_t;
+
+/************** Global Vars & Functions *******************/
+hole_t hole_text(const std::string &text) {
+    std::vector<poker::card_t> cards = poker::parse_cards(text);
+    return hole_t {{cards[0], cards[1]}};
+}
+
+TEST(UtilEquity, Choose) {
+    ASSERT_EQ(poker::choose(52, 5), 2598960);
+    ASSERT_EQ(poker::choose(48, 5), 1712304);
+    ASSERT_EQ(poker::choose(5, 0), 1);
+    ASSERT_EQ(poker::choose(3, 5), 0);
+}
+
+TEST(UtilEquity, InvalidInput) {
+    std::vector<hole_t> one = {hole_text("AH AD")};
+    ASSERT_THROW(poker::calc_equity(one), std::invalid_argument);
+
+    std::vector<hole_t> dupe = {hole_text("AH AD"), hole_text("AH KD")};
+    ASSERT_THROW(poker::calc_equity(dupe), std::invalid_argument);
+
+    std::vector<hole_t> holes = {hole_text("AH AD"), hole_text("KH KD")};
+    ASSERT_THROW(poker::calc_equity(holes, poker::parse_cards("2C 3C 4C 5C 6C 7C")),
+            std::invalid_argument);
+
+    poker::EquityConfig config;
+    config.exact_limit = 0;
+    config.max_samples = 0;
+    ASSERT_THROW(poker::calc_equity(holes, {}, config), std::invalid_argument);
+}
+
+TEST(UtilEquity, CompleteBoard) {
+    std::vector<hole_t> holes = {hole_text("AH AD"), hole_text("KH KD"), hole_text("2C 7S")};
+    poker::EquityResult res = poker::calc_equity(holes, poker::parse_cards("KS 9C 4D 3H JS"));
+    ASSERT_TRUE(res.exact);
+    ASSERT_EQ(res.boards, 1);
+    ASSERT_EQ(res.win[1], 1.0);
+    ASSERT_EQ(res.loss[0], 1.0);
+    ASSERT_EQ(res.loss[2], 1.0);
+}
+
+TEST(UtilEquity, SplitPot) {
+    // Board plays for both, every river is a chop.
+    std::vector<hole_t> holes = {hole_text("2H 3D"), hole_text("2C 3S")};
+    poker::EquityResult res = poker::calc_equity(holes, poker::parse_cards("TS JS QD KC"));
+    ASSERT_TRUE(res.exact);
+    ASSERT_EQ(res.boards, 44);
+    ASSERT_EQ(res.tie[0], 1.0);
+    ASSERT_DOUBLE_EQ(res.equity[0], 0.5);
+    ASSERT_DOUBLE_EQ(res.equity[1], 0.5);
+}
+
+TEST(UtilEquity, ExactFlop) {
+    std::vector<hole_t> holes = {hole_text("AH KH"), hole_text("QS QC")};
+    poker::EquityConfig config;
+    config.threads = 3;
+    poker::EquityResult res = poker::calc_equity(holes, poker::parse_cards("2H 7H TC"), config);
+    ASSERT_TRUE(res.exact);
+    ASSERT_EQ(res.boards, poker::choose(45, 2));
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_NEAR(res.win[i] + res.tie[i] + res.loss[i], 1.0, 1e-12);
+    }
+    ASSERT_NEAR(res.equity[0] + res.equity[1], 1.0, 1e-12);
+    ASSERT_NEAR(res.win[0], res.loss[1], 1e-12);
+
+    // Thread count must never change an exact answer.
+    config.threads = 1;
+    poker::EquityResult single = poker::calc_equity(holes, poker::parse_cards("2H 7H TC"), config);
+    ASSERT_EQ(single.win, res.win);
+    ASSERT_EQ(single.tie, res.tie);
+}
+
+TEST(UtilEquity, SampleMatchesExact) {
+    std::vector<hole_t> holes = {hole_text("AH AD"), hole_text("7C 8C"), hole_text("KS QS")};
+    std::vector<poker::card_t> board = poker::parse_cards("2C 9C");
+    poker::EquityResult exact = poker::calc_equity(holes, board);
+    ASSERT_TRUE(exact.exact);
+
+    poker::EquityConfig config;
+    config.exact_limit = 0;
+    config.threads = 4;
+    config.max_samples = 200000;
+    poker::EquityResult sampled = poker::calc_equity(holes, board, config);
+    ASSERT_FALSE(sampled.exact);
+    ASSERT_EQ(sampled.boards, config.max_samples);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_GT(sampled.std_error[i], 0.0);
+        ASSERT_NEAR(sampled.equity[i], exact.equity[i], 5 * sampled.std_error[i]);
+    }
+}
+
+TEST(UtilEquity, SampleStopsAtTarget) {
+    std::vector<hole_t> holes;
+    for (const char *text : {"AH AD", "KH KD", "QH QD", "JH JD", "TH TD", "9H 9D"}) {
+        holes.push_back(hole_text(text));
+    }
+    poker::EquityConfig config;
+    config.exact_limit = 0;
+    config.threads = 2;
+    config.target_error = 0.005;
+    poker::EquityResult res = poker::calc_equity(holes, std::vector<poker::card_t>(), config);
+    ASSERT_FALSE(res.exact);
+    ASSERT_LT(res.boards, config.max_samples);
+    for (double err : res.std_error) {
+        ASSERT_LE(err, config.target_error);
+    }
+    ASSERT_GT(res.equity[0], res.equity[5]);
+}
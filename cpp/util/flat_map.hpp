@@ -0,0 +1,106 @@
+#ifndef _FLAT_MAP_HPP_
+#define _FLAT_MAP_HPP_
+
+/********************* Header Files ***********************/
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+/************** Class & Func Declarations *****************/
+/*
+ * Insert only hash map kept flat: entries live contiguously in insertion
+ * order & an open addressed table (linear probing) holds their indices.
+ * Iterating walks the entries vector, no node is ever allocated.
+ */
+template <class Key, class Value, class Hash = std::hash<Key> >
+class FlatMap {
+public:
+    typedef std::pair<Key, Value> value_type;
+    typedef typename std::vector<value_type>::iterator iterator;
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+    explicit FlatMap(std::size_t expected = 0) {
+        reserve(expected);
+    }
+
+    Value & operator[](const Key &key) {
+        std::size_t slot = probe(key);
+        if (slots[slot] == EMPTY) {
+            if ((entries.size() + 1) * 2 > slots.size()) {
+                rehash(slots.size() * 2);
+                slot = probe(key);
+            }
+            slots[slot] = entries.size();
+            entries.push_back(value_type(key, Value()));
+        }
+
+        return entries[slots[slot]].second;
+    }
+    iterator find(const Key &key) {
+        std::size_t slot = probe(key);
+        return slots[slot] == EMPTY ? entries.end() : entries.begin() + slots[slot];
+    }
+    const_iterator find(const Key &key) const {
+        std::size_t slot = probe(key);
+        return slots[slot] == EMPTY ? entries.end() : entries.begin() + slots[slot];
+    }
+    std::size_t count(const Key &key) const {
+        return find(key) != entries.end();
+    }
+    /* Make room for expected entries without growing again. */
+    void reserve(std::size_t expected) {
+        std::size_t size = 16;
+        while (size < expected * 2) {
+            size *= 2;
+        }
+        if (size > slots.size()) {
+            rehash(size);
+        }
+        entries.reserve(expected);
+    }
+    void clear() {
+        entries.clear();
+        std::fill(slots.begin(), slots.end(), EMPTY);
+    }
+
+    iterator begin() { return entries.begin(); }
+    iterator end() { return entries.end(); }
+    const_iterator begin() const { return entries.begin(); }
+    const_iterator end() const { return entries.end(); }
+    std::size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+
+private:
+    static constexpr std::uint32_t EMPTY = 0xFFFFFFFF;
+
+    /* Slot holding key, else the empty slot it would go in. */
+    std::size_t probe(const Key &key) const {
+        // Spread the hash first, std::hash of an integer is the integer itself.
+        std::uint64_t mixed = static_cast<std::uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ULL;
+        const std::size_t mask = slots.size() - 1;
+        std::size_t slot = (mixed >> 32) & mask;
+        while (slots[slot] != EMPTY && !(entries[slots[slot]].first == key)) {
+            slot = (slot + 1) & mask;
+        }
+
+        return slot;
+    }
+    void rehash(std::size_t size) {
+        slots.assign(size, EMPTY);
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            slots[probe(entries[i].first)] = i;
+        }
+    }
+
+    // Data
+    std::vector<value_type> entries;
+    std::vector<std::uint32_t> slots;
+};
+
+} /* end util:: */
+
+#endif /* _FLAT_MAP_HPP_ */
@@ -0,0 +1,50 @@
+/**
+ * Test cases for the flat hash map
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <string>
+
+#include "gtest/gtest.h"
+#include "flat_map.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+
+/************** Global Vars & Functions *******************/
+TEST(UtilFlatMap, InsertFind) {
+    util::FlatMap<std::string, int> map;
+    ASSERT_TRUE(map.empty());
+    map["care"] = 1;
+    map["race"] += 2;
+    map["race"] += 2;
+
+    ASSERT_EQ(map.size(), 2);
+    ASSERT_EQ(map.find("race")->second, 4);
+    ASSERT_EQ(map.find("acre"), map.end());
+    ASSERT_EQ(map.count("care"), 1);
+    ASSERT_EQ(map.count("acre"), 0);
+}
+
+TEST(UtilFlatMap, GrowKeepsOrder) {
+    util::FlatMap<std::uint64_t, std::uint64_t> map;
+    for (std::uint64_t i = 0; i < 10000; ++i) {
+        map[i << 20] = i;
+    }
+
+    ASSERT_EQ(map.size(), 10000);
+    std::uint64_t expect = 0;
+    for (const auto &entry : map) {
+        ASSERT_EQ(entry.first, expect << 20);
+        ASSERT_EQ(entry.second, expect++);
+    }
+    for (std::uint64_t i = 0; i < 10000; ++i) {
+        ASSERT_EQ(map.find(i << 20)->second, i);
+    }
+
+    map.clear();
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.find(0), map.end());
+}
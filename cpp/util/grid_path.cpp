@@ -0,0 +1,553 @@
+/**
+ * Shortest paths over grids of cell weights.
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "grid_path.hpp"
+#include "parallel.hpp"
+#include "radix_heap.hpp"
+
+namespace util {
+
+/******************* Constants/Macros *********************/
+// Cells one delta_stepping task relaxes & the least frontier worth waking other threads for.
+static const std::size_t RELAX_CHUNK = 1024;
+static const std::size_t PARALLEL_FRONTIER = 4 * RELAX_CHUNK;
+// Side of the square blocks transpose copies, both fit in cache together.
+static const std::size_t TRANSPOSE_BLOCK = 64;
+// Least rows min_sum_three_way splits its column scans over workers for.
+static const std::size_t PARALLEL_SCAN_ROWS = 4 * SCAN_BLOCK;
+
+/************** Global Vars & Functions *******************/
+void check_weights(const Matrix<int> &matrix) {
+    if (std::any_of(matrix.data(), matrix.data() + matrix.size(), [](int cell) { return cell < 0; })) {
+        throw std::invalid_argument("Grid paths need non negative cell weights.");
+    }
+}
+
+void add_path_row(std::vector<int> &sums, const int *row, std::size_t cols) {
+    if (sums.empty()) {
+        sums.assign(row, row + cols);
+        std::partial_sum(sums.begin(), sums.end(), sums.begin());
+        return;
+    }
+
+    sums[0] += row[0];
+    for (std::size_t col = 1; col < cols; ++col) {
+        sums[col] = row[col] + std::min(sums[col], sums[col - 1]);
+    }
+}
+
+int min_sum_two_way(const Matrix<int> &matrix, std::vector<int> &sums) {
+    sums.clear();
+    for (std::size_t row = 0; row < matrix.rows(); ++row) {
+        add_path_row(sums, matrix.row(row), matrix.cols());
+    }
+
+    return sums.empty() ? 0 : sums.back();
+}
+
+void transpose(const Matrix<int> &matrix, Matrix<int> &out) {
+    out.resize(matrix.cols(), matrix.rows());
+    for (std::size_t row_start = 0; row_start < matrix.rows(); row_start += TRANSPOSE_BLOCK) {
+        const std::size_t row_end = std::min(matrix.rows(), row_start + TRANSPOSE_BLOCK);
+        for (std::size_t col_start = 0; col_start < matrix.cols(); col_start += TRANSPOSE_BLOCK) {
+            const std::size_t col_end = std::min(matrix.cols(), col_start + TRANSPOSE_BLOCK);
+            for (std::size_t row = row_start; row < row_end; ++row) {
+                for (std::size_t col = col_start; col < col_end; ++col) {
+                    out(col, row) = matrix(row, col);
+                }
+            }
+        }
+    }
+}
+
+void min_plus_scan(int *best, const int *cells, std::size_t count, bool up, std::size_t block,
+        WorkerPool *pool) {
+    // Walk cells by position, step flips the direction for up.
+    const std::ptrdiff_t step = up ? -1 : 1;
+    if (up && count > 0) {
+        best += count - 1;
+        cells += count - 1;
+    }
+    auto scan = [best, cells, step](std::size_t first, std::size_t last) {
+        for (std::size_t pos = first + 1; pos < last; ++pos) {
+            const std::ptrdiff_t at = step * std::ptrdiff_t(pos);
+            best[at] = std::min(best[at], best[at - step] + cells[at]);
+        }
+    };
+
+    const std::size_t blocks = block ? (count + block - 1) / block : 1;
+    if (pool == NULL || blocks < 2) {
+        scan(0, count);
+        return;
+    }
+
+    std::vector<int> totals(blocks), carries(blocks);
+    pool->run(blocks, [&](std::size_t index, unsigned) {
+        const std::size_t first = index * block, last = std::min(count, first + block);
+        scan(first, last);
+        int total = 0;
+        for (std::size_t pos = first; pos < last; ++pos) {
+            total += cells[step * std::ptrdiff_t(pos)];
+        }
+        totals[index] = total;
+    });
+
+    // Best sum into the last cell before each block, now that the blocks before it are known.
+    carries[1] = best[step * std::ptrdiff_t(block - 1)];
+    for (std::size_t index = 2; index < blocks; ++index) {
+        carries[index] = std::min(best[step * std::ptrdiff_t(index * block - 1)],
+                carries[index - 1] + totals[index - 1]);
+    }
+
+    // Once the carry fails to improve a cell it can't improve any after it.
+    pool->run(blocks - 1, [&](std::size_t task, unsigned) {
+        const std::size_t first = (task + 1) * block, last = std::min(count, first + block);
+        int sum = carries[task + 1];
+        for (std::size_t pos = first; pos < last; ++pos) {
+            const std::ptrdiff_t at = step * std::ptrdiff_t(pos);
+            sum += cells[at];
+            if (sum >= best[at]) {
+                break;
+            }
+            best[at] = sum;
+        }
+    });
+}
+
+int min_sum_three_way(const Matrix<int> &matrix, std::vector<int> &sums, Matrix<int> &columns,
+        unsigned threads) {
+    if (matrix.empty()) {
+        return 0;
+    }
+    transpose(matrix, columns);
+    const std::size_t rows = matrix.rows();
+    sums.assign(columns.row(0), columns.row(0) + rows);
+
+    std::unique_ptr<WorkerPool> pool;
+    const unsigned workers = worker_count(threads, rows / SCAN_BLOCK);
+    if (rows >= PARALLEL_SCAN_ROWS && workers > 1) {
+        pool.reset(new WorkerPool(workers));
+    }
+    for (std::size_t col = 1; col < columns.rows(); ++col) {
+        const int *cells = columns.row(col);
+        int *best = sums.data();
+        for (std::size_t row = 0; row < rows; ++row) {
+            best[row] += cells[row];
+        }
+        min_plus_scan(best, cells, rows, false, SCAN_BLOCK, pool.get());
+        min_plus_scan(best, cells, rows, true, SCAN_BLOCK, pool.get());
+    }
+
+    return *std::min_element(sums.begin(), sums.end());
+}
+
+std::vector<int> dijkstra(const Matrix<int> &matrix, std::size_t root, unsigned moves) {
+    std::vector<int> sums;
+    RadixHeap<std::uint32_t> heap;
+    dijkstra(matrix, root, moves, sums, heap);
+
+    return sums;
+}
+
+void dijkstra(const Matrix<int> &matrix, std::size_t root, unsigned moves, std::vector<int> &sums,
+        RadixHeap<std::uint32_t> &heap) {
+    check_weights(matrix);
+    sums.assign(matrix.size(), NO_PATH);
+    heap.clear();
+    if (matrix.empty()) {
+        return;
+    }
+
+    sums[root] = matrix[root];
+    heap.push(sums[root], root);
+    while (!heap.empty()) {
+        const RadixHeap<std::uint32_t>::value_type top = heap.pop();
+        const int sum = static_cast<int>(top.first);
+        if (sum != sums[top.second]) {
+            continue;  // Stale entry, index was settled with a smaller sum.
+        }
+
+        matrix.for_neighbors(top.second, moves, [&matrix, &sums, &heap, sum](std::size_t next) {
+            const int next_sum = sum + matrix[next];
+            if (next_sum < sums[next]) {
+                sums[next] = next_sum;
+                heap.push(next_sum, next);
+            }
+        });
+    }
+}
+
+int default_delta(const Matrix<int> &matrix) {
+    if (matrix.empty()) {
+        return 1;
+    }
+    const long long total = std::accumulate(matrix.data(), matrix.data() + matrix.size(), 0LL);
+
+    return std::max(1LL, total / static_cast<long long>(matrix.size()));
+}
+
+/* Lower sum to value if that is smaller, true if this call did. */
+inline bool atomic_min(std::atomic<int> &sum, int value) {
+    int seen = sum.load(std::memory_order_relaxed);
+    while (value < seen) {
+        if (sum.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::vector<int> delta_stepping(const Matrix<int> &matrix, std::size_t root, unsigned moves,
+        int delta, unsigned threads) {
+    check_weights(matrix);
+    if (matrix.empty()) {
+        return std::vector<int>();
+    }
+    delta = delta > 0 ? delta : default_delta(matrix);
+    // Started once, there is a light round per bucket change & thread start up would swamp them.
+    WorkerPool pool(worker_count(threads, matrix.size()));
+
+    // A relaxation from bucket b lands below b + max / delta + 2, so a ring that long never wraps onto itself.
+    const int max_weight = *std::max_element(matrix.data(), matrix.data() + matrix.size());
+    std::vector<std::vector<std::size_t>> buckets(max_weight / delta + 2);
+    std::vector<std::atomic<int>> sums(matrix.size());
+    for (std::atomic<int> &sum : sums) {
+        sum.store(NO_PATH, std::memory_order_relaxed);
+    }
+    std::vector<std::vector<std::pair<std::size_t, int>>> updates(pool.size());
+    std::size_t pending = 0;
+
+    // Relax the light or heavy moves out of from, then file each cell whose sum dropped in its bucket.
+    auto relax = [&](const std::vector<std::size_t> &from, bool light) {
+        auto relax_chunk = [&](std::size_t chunk, unsigned worker) {
+            std::vector<std::pair<std::size_t, int>> &found = updates[worker];
+            const std::size_t end = std::min(from.size(), (chunk + 1) * RELAX_CHUNK);
+            for (std::size_t task = chunk * RELAX_CHUNK; task < end; ++task) {
+                const int sum = sums[from[task]].load(std::memory_order_relaxed);
+                matrix.for_neighbors(from[task], moves, [&](std::size_t next) {
+                    const int weight = matrix[next];
+                    if ((weight <= delta) == light && atomic_min(sums[next], sum + weight)) {
+                        found.push_back(std::make_pair(next, sum + weight));
+                    }
+                });
+            }
+        };
+        const std::size_t chunks = (from.size() + RELAX_CHUNK - 1) / RELAX_CHUNK;
+        if (from.size() >= PARALLEL_FRONTIER) {
+            pool.run(chunks, relax_chunk);
+        } else {
+            for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                relax_chunk(chunk, 0);
+            }
+        }
+
+        // Only the last drop of a cell still matches its sum, so each is filed once per call.
+        for (std::vector<std::pair<std::size_t, int>> &found : updates) {
+            for (const std::pair<std::size_t, int> &update : found) {
+                if (sums[update.first].load(std::memory_order_relaxed) == update.second) {
+                    buckets[update.second / delta % buckets.size()].push_back(update.first);
+                    ++pending;
+                }
+            }
+            found.clear();
+        }
+    };
+
+    sums[root] = matrix[root];
+    buckets[matrix[root] / delta % buckets.size()].push_back(root);
+    pending = 1;
+    // A cell may be filed again before it is taken, round & settled_in drop the repeats.
+    std::vector<std::size_t> taken_round(matrix.size(), 0), settled_in(matrix.size(), std::numeric_limits<std::size_t>::max());
+    std::vector<std::size_t> taken, frontier, settled;
+    std::size_t round = 0;
+    for (std::size_t current = matrix[root] / delta; pending != 0; ++current) {
+        std::vector<std::size_t> &bucket = buckets[current % buckets.size()];
+        settled.clear();
+        while (!bucket.empty()) {
+            taken.clear();
+            taken.swap(bucket);
+            pending -= taken.size();
+            frontier.clear();
+            ++round;
+            for (std::size_t index : taken) {
+                if (sums[index].load(std::memory_order_relaxed) / delta != static_cast<int>(current)
+                        || taken_round[index] == round) {
+                    continue;
+                }
+                taken_round[index] = round;
+                frontier.push_back(index);
+                if (settled_in[index] != current) {
+                    settled_in[index] = current;
+                    settled.push_back(index);
+                }
+            }
+            relax(frontier, true);
+        }
+        relax(settled, false);
+    }
+
+    std::vector<int> result(matrix.size());
+    for (std::size_t index = 0; index < matrix.size(); ++index) {
+        result[index] = sums[index].load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+unsigned reverse_moves(unsigned moves) {
+    return ((moves & MOVE_UP) ? MOVE_DOWN : 0) | ((moves & MOVE_DOWN) ? MOVE_UP : 0)
+        | ((moves & MOVE_LEFT) ? MOVE_RIGHT : 0) | ((moves & MOVE_RIGHT) ? MOVE_LEFT : 0);
+}
+
+/* Throws std::out_of_range unless source & target are cells of matrix. */
+inline void check_cells(const Matrix<int> &matrix, std::size_t source, std::size_t target) {
+    if (source >= matrix.size() || target >= matrix.size()) {
+        throw std::out_of_range("Path source & target must be cells of the matrix.");
+    }
+}
+
+GridPath astar(const Matrix<int> &matrix, std::size_t source, std::size_t target, unsigned moves) {
+    check_weights(matrix);
+    if (matrix.empty()) {
+        return GridPath();
+    }
+    check_cells(matrix, source, target);
+    const int min_weight = *std::min_element(matrix.data(), matrix.data() + matrix.size());
+    const long long target_row = matrix.row_of(target), target_col = matrix.col_of(target);
+    auto estimate = [&matrix, min_weight, target_row, target_col](std::size_t index) {
+        const long long row = matrix.row_of(index), col = matrix.col_of(index);
+        return min_weight * static_cast<int>(std::abs(row - target_row) + std::abs(col - target_col));
+    };
+
+    GridPath path;
+    std::vector<int> sums(matrix.size(), NO_PATH);
+    std::vector<std::size_t> pred(matrix.size(), NO_CELL);
+    RadixHeap<std::uint32_t> heap;
+    sums[source] = matrix[source];
+    heap.push(sums[source] + estimate(source), source);
+    while (!heap.empty()) {
+        const RadixHeap<std::uint32_t>::value_type top = heap.pop();
+        const std::size_t index = top.second;
+        if (static_cast<int>(top.first) != sums[index] + estimate(index)) {
+            continue;
+        }
+        ++path.settled;
+        if (index == target) {
+            break;
+        }
+
+        matrix.for_neighbors(index, moves, [&](std::size_t next) {
+            const int next_sum = sums[index] + matrix[next];
+            if (next_sum < sums[next]) {
+                sums[next] = next_sum;
+                pred[next] = index;
+                heap.push(next_sum + estimate(next), next);
+            }
+        });
+    }
+
+    if (sums[target] != NO_PATH) {
+        path.sum = sums[target];
+        for (std::size_t cell = target; cell != NO_CELL; cell = pred[cell]) {
+            path.cells.push_back(cell);
+        }
+        std::reverse(path.cells.begin(), path.cells.end());
+    }
+
+    return path;
+}
+
+GridPath bidirectional(const Matrix<int> &matrix, std::size_t source, std::size_t target, unsigned moves) {
+    check_weights(matrix);
+    if (matrix.empty()) {
+        return GridPath();
+    }
+    check_cells(matrix, source, target);
+    const unsigned back_moves = reverse_moves(moves);
+
+    // ahead counts source through the cell, behind the cells after it through target.
+    GridPath path;
+    std::vector<int> ahead(matrix.size(), NO_PATH), behind(matrix.size(), NO_PATH);
+    std::vector<std::size_t> pred(matrix.size(), NO_CELL), succ(matrix.size(), NO_CELL);
+    RadixHeap<std::uint32_t> forward, backward;
+    long long best = NO_PATH;
+    std::size_t meet = NO_CELL;
+    auto consider = [&ahead, &behind, &best, &meet](std::size_t index) {
+        if (ahead[index] != NO_PATH && behind[index] != NO_PATH
+                && static_cast<long long>(ahead[index]) + behind[index] < best) {
+            best = static_cast<long long>(ahead[index]) + behind[index];
+            meet = index;
+        }
+    };
+
+    ahead[source] = matrix[source];
+    forward.push(ahead[source], source);
+    behind[target] = 0;
+    backward.push(0, target);
+    consider(source);
+    while (!forward.empty() && !backward.empty()) {
+        const std::uint32_t forward_key = forward.top_key(), backward_key = backward.top_key();
+        if (static_cast<long long>(forward_key) + backward_key >= best) {
+            break;
+        }
+
+        if (forward_key <= backward_key) {
+            const std::size_t index = forward.pop().second;
+            if (static_cast<int>(forward_key) != ahead[index]) {
+                continue;
+            }
+            ++path.settled;
+            matrix.for_neighbors(index, moves, [&](std::size_t next) {
+                const int next_sum = ahead[index] + matrix[next];
+                if (next_sum < ahead[next]) {
+                    ahead[next] = next_sum;
+                    pred[next] = index;
+                    forward.push(next_sum, next);
+                    consider(next);
+                }
+            });
+        } else {
+            const std::size_t index = backward.pop().second;
+            if (static_cast<int>(backward_key) != behind[index]) {
+                continue;
+            }
+            ++path.settled;
+            const int prev_sum = behind[index] + matrix[index];
+            matrix.for_neighbors(index, back_moves, [&](std::size_t prev) {
+                if (prev_sum < behind[prev]) {
+                    behind[prev] = prev_sum;
+                    succ[prev] = index;
+                    backward.push(prev_sum, prev);
+                    consider(prev);
+                }
+            });
+        }
+    }
+
+    if (meet != NO_CELL) {
+        path.sum = static_cast<int>(best);
+        for (std::size_t cell = meet; cell != NO_CELL; cell = pred[cell]) {
+            path.cells.push_back(cell);
+        }
+        std::reverse(path.cells.begin(), path.cells.end());
+        for (std::size_t cell = succ[meet]; cell != NO_CELL; cell = succ[cell]) {
+            path.cells.push_back(cell);
+        }
+    }
+
+    return path;
+}
+
+DynamicGridPath::DynamicGridPath(const Matrix<int> &matrix, std::size_t root, unsigned moves) :
+        matrix(matrix), root(root), moves(moves), cell_sums(matrix.size(), NO_PATH),
+        preds(matrix.size(), NO_CELL) {
+    check_weights(matrix);
+    if (!matrix.empty()) {
+        cell_sums[root] = matrix[root];
+        heap.push(cell_sums[root], root);
+        settle();
+    }
+}
+
+void DynamicGridPath::set_weight(std::size_t index, int weight) {
+    if (weight < 0) {
+        throw std::invalid_argument("Grid paths need non negative cell weights.");
+    }
+    const int old_weight = matrix[index];
+    matrix[index] = weight;
+    heap.clear();
+    settled = 0;
+    // Which cells are reachable never depends on weights.
+    if (weight == old_weight || cell_sums[index] == NO_PATH) {
+        return;
+    }
+
+    if (weight < old_weight) {
+        // The best way into index is unchanged, it just costs less now.
+        cell_sums[index] -= old_weight - weight;
+        heap.push(cell_sums[index], index);
+        settle();
+        return;
+    }
+
+    affected.clear();
+    affected.push_back(index);
+    for (std::size_t taken = 0; taken < affected.size(); ++taken) {
+        const std::size_t cell = affected[taken];
+        matrix.for_neighbors(cell, moves, [this, cell](std::size_t next) {
+            if (preds[next] == cell) {
+                affected.push_back(next);
+            }
+        });
+    }
+    for (std::size_t cell : affected) {
+        cell_sums[cell] = NO_PATH;
+        preds[cell] = NO_CELL;
+    }
+
+    // Every cleared cell starts at its best sum through a neighbor still holding one.
+    const unsigned back_moves = reverse_moves(moves);
+    if (index == root) {
+        cell_sums[root] = matrix[root];
+    }
+    for (std::size_t cell : affected) {
+        matrix.for_neighbors(cell, back_moves, [this, cell](std::size_t prev) {
+            if (cell_sums[prev] != NO_PATH && cell_sums[prev] + matrix[cell] < cell_sums[cell]) {
+                cell_sums[cell] = cell_sums[prev] + matrix[cell];
+                preds[cell] = prev;
+            }
+        });
+        if (cell_sums[cell] != NO_PATH) {
+            heap.push(cell_sums[cell], cell);
+        }
+    }
+    settle();
+}
+
+std::vector<std::size_t> DynamicGridPath::path(std::size_t target) const {
+    std::vector<std::size_t> cells;
+    if (cell_sums[target] != NO_PATH) {
+        for (std::size_t cell = target; cell != NO_CELL; cell = preds[cell]) {
+            cells.push_back(cell);
+        }
+        std::reverse(cells.begin(), cells.end());
+    }
+
+    return cells;
+}
+
+/* Dijkstra from whatever is on the heap, counting settled cells. */
+void DynamicGridPath::settle() {
+    while (!heap.empty()) {
+        const RadixHeap<std::uint32_t>::value_type top = heap.pop();
+        const std::size_t index = top.second;
+        if (static_cast<int>(top.first) != cell_sums[index]) {
+            continue;
+        }
+        ++settled;
+
+        matrix.for_neighbors(index, moves, [this, index](std::size_t next) {
+            const int next_sum = cell_sums[index] + matrix[next];
+            if (next_sum < cell_sums[next]) {
+                cell_sums[next] = next_sum;
+                preds[next] = index;
+                heap.push(next_sum, next);
+            }
+        });
+    }
+}
+
+} /* end util:: */
@@ -0,0 +1,161 @@
+#ifndef _GRID_PATH_HPP_
+#define _GRID_PATH_HPP_
+
+/********************* Header Files ***********************/
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "matrix.hpp"
+#include "radix_heap.hpp"
+
+namespace util {
+
+/******************* Constants/Macros *********************/
+// Sum of a cell no path reaches.
+static const int NO_PATH = std::numeric_limits<int>::max();
+// Predecessor of a cell with none.
+static const std::size_t NO_CELL = std::numeric_limits<std::size_t>::max();
+// Rows min_plus_scan gives each task when scanning in blocks.
+static const std::size_t SCAN_BLOCK = 4096;
+
+class WorkerPool;
+
+/************** Class & Func Declarations *****************/
+/*
+ * Minimal path sums over a grid of non negative cell weights, a path's sum
+ * counting every cell on it including both ends. Sums must fit in an int.
+ */
+
+// A path between two cells with the cost of finding it.
+class GridPath {
+public:
+    // NO_PATH & no cells when the target can't be reached.
+    int sum = NO_PATH;
+    // Source to target inclusive.
+    std::vector<std::size_t> cells;
+    // Cells whose sum the search finalized, over both directions if bidirectional.
+    std::size_t settled = 0;
+};
+
+/* Throws std::invalid_argument if any cell of matrix is negative. */
+void check_weights(const Matrix<int> &matrix);
+
+/*
+ * Row kernel of the right & down model: fold the next row of cols cells into sums,
+ * which holds the minimal sum into each cell of the previous row or is empty before the first.
+ */
+void add_path_row(std::vector<int> &sums, const int *row, std::size_t cols);
+
+/* Minimal sum from top left to bottom right moving right & down, one row of sums kept in sums. 0 if empty. */
+int min_sum_two_way(const Matrix<int> &matrix, std::vector<int> &sums);
+
+/* Fill out with matrix's rows & columns swapped, in cache sized blocks, reusing out's memory. */
+void transpose(const Matrix<int> &matrix, Matrix<int> &out);
+
+/*
+ * best[i] = min(best[i], best[i - 1] + cells[i]) for every i of count in turn, running
+ * from the last i back to the first when up. That is an associative min plus scan, so
+ * given a pool it runs in blocks of block cells: each block scans alone & totals its
+ * cells, the sums carried into each block are chained serially, then every block folds
+ * its carry in until the carry stops improving a cell. NULL pool scans in one pass.
+ */
+void min_plus_scan(int *best, const int *cells, std::size_t count, bool up,
+        std::size_t block = SCAN_BLOCK, WorkerPool *pool = NULL);
+
+/*
+ * Minimal sum from any cell of the left column to any of the right moving up, right & down.
+ * Column by column: step right, then relax down & up once each with min_plus_scan, as a
+ * minimal path never turns back within a column. matrix is transposed into columns first
+ * so every pass runs over a flat row, pass the same buffer to reuse its memory.
+ * Tall columns are scanned in blocks on threads workers (0 for all cores). 0 if empty.
+ */
+int min_sum_three_way(const Matrix<int> &matrix, std::vector<int> &sums, Matrix<int> &columns,
+        unsigned threads = 1);
+
+/*
+ * Minimal sum from root to every cell moving by moves, NO_PATH where unreachable.
+ * Dijkstra on a RadixHeap, O(cells * log of the largest sum).
+ * Throws std::invalid_argument on negative weights.
+ */
+std::vector<int> dijkstra(const Matrix<int> &matrix, std::size_t root = 0, unsigned moves = MOVES_FOUR);
+/* As above but filling sums & working in heap, so repeated calls reuse their memory. */
+void dijkstra(const Matrix<int> &matrix, std::size_t root, unsigned moves, std::vector<int> &sums,
+        RadixHeap<std::uint32_t> &heap);
+
+/* Bucket width delta_stepping picks when given none, the mean cell weight & at least 1. */
+int default_delta(const Matrix<int> &matrix);
+
+/*
+ * Same sums as dijkstra, found by delta stepping on threads workers (0 for all cores).
+ * Cells are bucketed by sum / delta. Moves into cells weighing at most delta (light)
+ * are relaxed until the current bucket stops changing, then heavier moves are
+ * relaxed once from everything that bucket settled. Every relaxation is an atomic
+ * min on a shared flat array, run on one WorkerPool for the whole solve.
+ * delta 0 means default_delta.
+ */
+std::vector<int> delta_stepping(const Matrix<int> &matrix, std::size_t root = 0,
+        unsigned moves = MOVES_FOUR, int delta = 0, unsigned threads = 0);
+
+/* Mask of the moves that undo moves, up for down & left for right. */
+unsigned reverse_moves(unsigned moves);
+
+/*
+ * Minimal path from source to target, stopping once target is settled.
+ * A* guided by the least cell weight times the Manhattan distance to target,
+ * which never overestimates & never drops by more than a step costs,
+ * so the RadixHeap stays monotone. Throws std::invalid_argument on negative weights
+ * & std::out_of_range if source or target isn't a cell. No path for an empty matrix.
+ */
+GridPath astar(const Matrix<int> &matrix, std::size_t source, std::size_t target,
+        unsigned moves = MOVES_FOUR);
+
+/*
+ * As astar but two Dijkstra searches, from source & backwards from target,
+ * taking turns by lower top key until those keys together reach the best
+ * meeting sum seen.
+ */
+GridPath bidirectional(const Matrix<int> &matrix, std::size_t source, std::size_t target,
+        unsigned moves = MOVES_FOUR);
+
+/*
+ * Minimal sums from root to every cell that stay current as cell weights change.
+ * Lowering a weight pushes the saving out from that cell with Dijkstra. Raising
+ * one clears the cells whose best path ran through it (its subtree of the
+ * predecessor tree), seeds them from their untouched neighbors & settles only those.
+ * Either way the work is about the size of the region whose sums change.
+ */
+class DynamicGridPath {
+public:
+    /* Throws std::invalid_argument on negative weights. */
+    DynamicGridPath(const Matrix<int> &matrix, std::size_t root = 0, unsigned moves = MOVES_FOUR);
+
+    /* Set the weight of index & repair the sums, throws std::invalid_argument if weight is negative. */
+    void set_weight(std::size_t index, int weight);
+
+    /* Cells from root to target inclusive, empty if target can't be reached. */
+    std::vector<std::size_t> path(std::size_t target) const;
+
+    int sum(std::size_t index) const { return cell_sums[index]; }
+    const std::vector<int> & sums() const { return cell_sums; }
+    const Matrix<int> & weights() const { return matrix; }
+    /* Cells settled by the constructor or the last set_weight. */
+    std::size_t last_settled() const { return settled; }
+
+private:
+    void settle();
+
+    Matrix<int> matrix;
+    std::size_t root;
+    unsigned moves;
+    std::vector<int> cell_sums;
+    std::vector<std::size_t> preds;
+    RadixHeap<std::uint32_t> heap;
+    std::vector<std::size_t> affected;
+    std::size_t settled = 0;
+};
+
+} /* end util:: */
+
+#endif /* _GRID_PATH_HPP_ */
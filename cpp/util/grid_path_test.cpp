@@ -0,0 +1,274 @@
+/**
+ * Test cases for grid shortest paths
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "grid_path.hpp"
+#include "parallel.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+
+/************** Global Vars & Functions *******************/
+util::Matrix<int> random_grid(std::size_t rows, std::size_t cols, int max_weight, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(0, max_weight);
+    util::Matrix<int> matrix(rows, cols);
+    for (std::size_t index = 0; index < matrix.size(); ++index) {
+        matrix[index] = dist(gen);
+    }
+
+    return matrix;
+}
+
+/* Relax every cell until nothing changes, slow but obviously right. */
+std::vector<int> relax_all(const util::Matrix<int> &matrix, std::size_t root, unsigned moves) {
+    std::vector<int> sums(matrix.size(), util::NO_PATH);
+    sums[root] = matrix[root];
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (std::size_t index = 0; index < matrix.size(); ++index) {
+            if (sums[index] == util::NO_PATH) {
+                continue;
+            }
+            matrix.for_neighbors(index, moves, [&](std::size_t next) {
+                if (sums[index] + matrix[next] < sums[next]) {
+                    sums[next] = sums[index] + matrix[next];
+                    changed = true;
+                }
+            });
+        }
+    }
+
+    return sums;
+}
+
+TEST(UtilGridPath, Dijkstra) {
+    util::Matrix<int> matrix(3, 3, std::vector<int>({
+        1, 9, 1,
+        1, 9, 1,
+        1, 1, 1,
+    }));
+    std::vector<int> sums = util::dijkstra(matrix);
+    ASSERT_EQ(sums.back(), 5);
+    ASSERT_EQ(sums[2], 7);
+    ASSERT_EQ(util::dijkstra(matrix, 0, util::MOVES_TWO)[2], 11);
+    ASSERT_EQ(util::dijkstra(matrix, 8, util::MOVES_TWO)[0], util::NO_PATH);
+
+    matrix[4] = -1;
+    ASSERT_THROW(util::dijkstra(matrix), std::invalid_argument);
+}
+
+TEST(UtilGridPath, DijkstraMatchesRelax) {
+    unsigned seed = 0;
+    for (unsigned moves : {util::MOVES_TWO, util::MOVES_THREE, util::MOVES_FOUR}) {
+        for (int max_weight : {0, 3, 9999}) {
+            util::Matrix<int> matrix = random_grid(23, 31, max_weight, ++seed);
+            for (std::size_t root : {std::size_t(0), std::size_t(400)}) {
+                ASSERT_EQ(util::dijkstra(matrix, root, moves), relax_all(matrix, root, moves));
+            }
+        }
+    }
+}
+
+TEST(UtilGridPath, RowKernelsMatchRelax) {
+    std::vector<int> sums;
+    util::Matrix<int> columns;
+    unsigned seed = 10;
+    for (auto shape : {std::make_pair(1, 1), std::make_pair(1, 17), std::make_pair(19, 1),
+            std::make_pair(70, 65), std::make_pair(23, 31)}) {
+        util::Matrix<int> matrix = random_grid(shape.first, shape.second, 9999, ++seed);
+        ASSERT_EQ(util::min_sum_two_way(matrix, sums), relax_all(matrix, 0, util::MOVES_TWO).back());
+
+        // Best of every left to right relaxation, columns reused from the last shape.
+        int expect = util::NO_PATH;
+        for (std::size_t row = 0; row < matrix.rows(); ++row) {
+            std::vector<int> from = relax_all(matrix, matrix.index(row, 0), util::MOVES_THREE);
+            for (std::size_t end = 0; end < matrix.rows(); ++end) {
+                expect = std::min(expect, from[matrix.index(end, matrix.cols() - 1)]);
+            }
+        }
+        ASSERT_EQ(util::min_sum_three_way(matrix, sums, columns), expect);
+        ASSERT_EQ(columns.rows(), matrix.cols());
+        ASSERT_EQ(columns(columns.rows() - 1, 0), matrix(0, matrix.cols() - 1));
+    }
+    ASSERT_EQ(util::min_sum_two_way(util::Matrix<int>(), sums), 0);
+    ASSERT_EQ(util::min_sum_three_way(util::Matrix<int>(), sums, columns), 0);
+}
+
+TEST(UtilGridPath, BlockedScanMatchesSerial) {
+    util::WorkerPool pool(3);
+    std::mt19937 gen(45);
+    std::uniform_int_distribution<int> dist(0, 9999);
+    for (std::size_t count : {0, 1, 7, 64, 1000}) {
+        std::vector<int> cells(count), start(count);
+        for (std::size_t index = 0; index < count; ++index) {
+            cells[index] = dist(gen);
+            start[index] = dist(gen) * (index % 5 + 1);
+        }
+        for (bool up : {false, true}) {
+            std::vector<int> expect = start;
+            for (std::size_t step = 1; step < count; ++step) {
+                const std::size_t index = up ? count - 1 - step : step, prev = up ? index + 1 : index - 1;
+                expect[index] = std::min(expect[index], expect[prev] + cells[index]);
+            }
+            std::vector<int> serial = start;
+            util::min_plus_scan(serial.data(), cells.data(), count, up);
+            ASSERT_EQ(serial, expect);
+            for (std::size_t block : {1, 3, 16, 999}) {
+                std::vector<int> best = start;
+                util::min_plus_scan(best.data(), cells.data(), count, up, block, &pool);
+                ASSERT_EQ(best, expect);
+            }
+        }
+    }
+}
+
+TEST(UtilGridPath, DeltaSteppingMatchesDijkstra) {
+    unsigned seed = 100;
+    for (unsigned moves : {util::MOVES_TWO, util::MOVES_THREE, util::MOVES_FOUR}) {
+        for (int max_weight : {0, 1, 9, 9999}) {
+            util::Matrix<int> matrix = random_grid(97, 113, max_weight, ++seed);
+            const std::vector<int> expect = util::dijkstra(matrix, 50, moves);
+            for (int delta : {0, 1, 7, 20000}) {
+                ASSERT_EQ(util::delta_stepping(matrix, 50, moves, delta, 3), expect);
+            }
+        }
+    }
+}
+
+/* Sum of path's cells after checking it runs from source to target by moves. */
+int walk(const util::Matrix<int> &matrix, const util::GridPath &path, std::size_t source,
+        std::size_t target, unsigned moves) {
+    EXPECT_EQ(path.cells.front(), source);
+    EXPECT_EQ(path.cells.back(), target);
+    int sum = matrix[path.cells.front()];
+    for (std::size_t step = 1; step < path.cells.size(); ++step) {
+        bool adjacent = false;
+        matrix.for_neighbors(path.cells[step - 1], moves, [&](std::size_t next) {
+            adjacent = adjacent || next == path.cells[step];
+        });
+        EXPECT_TRUE(adjacent);
+        sum += matrix[path.cells[step]];
+    }
+
+    return sum;
+}
+
+TEST(UtilGridPath, PointToPoint) {
+    util::Matrix<int> matrix(3, 3, std::vector<int>({
+        1, 9, 1,
+        1, 9, 1,
+        1, 1, 1,
+    }));
+    const std::vector<std::size_t> expect({0, 3, 6, 7, 8, 5, 2});
+    util::GridPath path = util::astar(matrix, 0, 2);
+    ASSERT_EQ(path.sum, 7);
+    ASSERT_EQ(path.cells, expect);
+    path = util::bidirectional(matrix, 0, 2);
+    ASSERT_EQ(path.sum, 7);
+    ASSERT_EQ(path.cells, expect);
+
+    ASSERT_EQ(util::astar(matrix, 4, 4).cells, std::vector<std::size_t>({4}));
+    ASSERT_EQ(util::bidirectional(matrix, 4, 4).sum, 9);
+    ASSERT_EQ(util::astar(matrix, 8, 0, util::MOVES_TWO).sum, util::NO_PATH);
+    ASSERT_TRUE(util::bidirectional(matrix, 8, 0, util::MOVES_TWO).cells.empty());
+    ASSERT_EQ(util::reverse_moves(util::MOVES_THREE), util::MOVE_UP | util::MOVE_LEFT | util::MOVE_DOWN);
+}
+
+TEST(UtilGridPath, PointToPointMatchesDijkstra) {
+    unsigned seed = 200;
+    std::mt19937 gen(48);
+    for (unsigned moves : {util::MOVES_TWO, util::MOVES_THREE, util::MOVES_FOUR}) {
+        for (int max_weight : {0, 5, 9999}) {
+            util::Matrix<int> matrix = random_grid(41, 37, max_weight, ++seed);
+            for (int pair = 0; pair < 10; ++pair) {
+                const std::size_t source = gen() % matrix.size(), target = gen() % matrix.size();
+                const int expect = util::dijkstra(matrix, source, moves)[target];
+                for (const util::GridPath &path : {util::astar(matrix, source, target, moves),
+                        util::bidirectional(matrix, source, target, moves)}) {
+                    ASSERT_EQ(path.sum, expect);
+                    if (expect != util::NO_PATH) {
+                        ASSERT_EQ(walk(matrix, path, source, target, moves), expect);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(UtilGridPath, PointToPointSettled) {
+    util::Matrix<int> matrix = random_grid(1000, 1000, 9, 49);
+    for (std::size_t index = 0; index < matrix.size(); ++index) {
+        matrix[index] += 1;
+    }
+    const std::size_t source = matrix.index(400, 400), target = matrix.index(450, 470);
+    const int expect = util::dijkstra(matrix, source)[target];
+
+    util::GridPath forward = util::astar(matrix, source, target);
+    util::GridPath both = util::bidirectional(matrix, source, target);
+    ASSERT_EQ(forward.sum, expect);
+    ASSERT_EQ(both.sum, expect);
+    ASSERT_LT(forward.settled, matrix.size() / 10);
+    ASSERT_LT(both.settled, matrix.size() / 10);
+}
+
+TEST(UtilGridPath, PointToPointBadCells) {
+    util::Matrix<int> empty;
+    ASSERT_EQ(util::astar(empty, 0, 0).sum, util::NO_PATH);
+    ASSERT_TRUE(util::bidirectional(empty, 0, 0).cells.empty());
+
+    util::Matrix<int> matrix = random_grid(3, 4, 9, 48);
+    ASSERT_THROW(util::astar(matrix, 12, 0), std::out_of_range);
+    ASSERT_THROW(util::astar(matrix, 0, 12), std::out_of_range);
+    ASSERT_THROW(util::bidirectional(matrix, 12, 0), std::out_of_range);
+    ASSERT_THROW(util::bidirectional(matrix, 0, 12), std::out_of_range);
+}
+
+TEST(UtilGridPath, DynamicMatchesDijkstra) {
+    std::mt19937 gen(49);
+    unsigned seed = 300;
+    for (unsigned moves : {util::MOVES_TWO, util::MOVES_THREE, util::MOVES_FOUR}) {
+        util::Matrix<int> matrix = random_grid(30, 40, 50, ++seed);
+        const std::size_t root = moves == util::MOVES_FOUR ? matrix.index(12, 20) : 0;
+        util::DynamicGridPath dynamic(matrix, root, moves);
+        ASSERT_EQ(dynamic.sums(), util::dijkstra(matrix, root, moves));
+        ASSERT_EQ(dynamic.last_settled(), matrix.size());
+
+        for (int update = 0; update < 300; ++update) {
+            const std::size_t index = update % 50 == 0 ? root : gen() % matrix.size();
+            dynamic.set_weight(index, gen() % 4 ? gen() % 51 : 0);
+            const std::vector<int> expect = util::dijkstra(dynamic.weights(), root, moves);
+            ASSERT_EQ(dynamic.sums(), expect);
+
+            const std::size_t target = gen() % matrix.size();
+            std::vector<std::size_t> cells = dynamic.path(target);
+            int sum = 0;
+            for (std::size_t cell : cells) {
+                sum += dynamic.weights()[cell];
+            }
+            ASSERT_EQ(cells.empty() ? util::NO_PATH : sum, expect[target]);
+        }
+    }
+    ASSERT_THROW(util::DynamicGridPath(util::Matrix<int>(2, 2, -1)), std::invalid_argument);
+}
+
+TEST(UtilGridPath, DynamicLocalRepair) {
+    util::Matrix<int> matrix = random_grid(200, 200, 9999, 50);
+    util::DynamicGridPath dynamic(matrix);
+    const std::size_t index = matrix.index(195, 190);
+    dynamic.set_weight(index, matrix[index] + 5000);
+    ASSERT_LT(dynamic.last_settled(), matrix.size() / 100);
+    dynamic.set_weight(index, 0);
+    ASSERT_LT(dynamic.last_settled(), matrix.size() / 100);
+    ASSERT_EQ(dynamic.sums(), util::dijkstra(dynamic.weights()));
+}
@@ -0,0 +1,187 @@
+/**
+ * Chunk parallel processing of large two player hand logs.
+ * Cards are parsed straight out of the mapped file, no line is ever copied.
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "hand_log.hpp"
+#include "mapped_file.hpp"
+
+namespace util {
+
+namespace poker {
+
+/***************** Constants & Macros *********************/
+static const int HAND_SIZE = 5;
+// Chunks per thread, extra chunks even out lines that cost more.
+static const std::size_t CHUNKS_PER_THREAD = 8;
+static const std::size_t MIN_CHUNK = 1 << 16;
+
+/************** Global Vars & Functions *******************/
+void LogStats::merge(const LogStats &other) {
+    lines += other.lines;
+    bad_lines += other.bad_lines;
+    ties += other.ties;
+    for (int player = 0; player < LOG_PLAYERS; ++player) {
+        wins[player] += other.wins[player];
+        for (int cat = 0; cat < NUM_CATEGORIES; ++cat) {
+            categories[player][cat] += other.categories[player][cat];
+        }
+    }
+}
+
+inline bool is_blank(char letter) {
+    return letter == ' ' || letter == '\t' || letter == '\r';
+}
+
+/*
+ * Parse one line, which excludes the newline, into cards.
+ * Returns the cards found: 0 for a blank line, -1 if malformed.
+ */
+inline int parse_line(const char *cur, const char *end, card_t *cards) {
+    int num_cards = 0;
+    while (cur != end) {
+        if (is_blank(*cur)) {
+            ++cur;
+            continue;
+        }
+
+        if (end - cur < 2 || num_cards == LOG_PLAYERS * HAND_SIZE ||
+                !parse_card(cur, cards[num_cards]) || (end - cur > 2 && !is_blank(cur[2]))) {
+            return -1;
+        }
+        ++num_cards;
+        cur += 2;
+    }
+
+    return num_cards == 0 || num_cards == LOG_PLAYERS * HAND_SIZE ? num_cards : -1;
+}
+
+// Deals waiting to be settled, every player's hand evaluated in one struct of arrays batch.
+// Card j of player p in deal d sits at cards[j][p * BATCH_SIZE + d].
+class DealBatch {
+public:
+    void add(const card_t *deal, LogStats &stats) {
+        for (int player = 0; player < LOG_PLAYERS; ++player) {
+            for (int j = 0; j < HAND_SIZE; ++j) {
+                cards[j][player * BATCH_SIZE + size] = deal[player * HAND_SIZE + j];
+            }
+        }
+        if (++size == BATCH_SIZE) {
+            settle(stats);
+        }
+    }
+
+    // Unused lanes of a partial batch hold stale cards, their results are ignored.
+    void settle(LogStats &stats) {
+        if (size == 0) {
+            return;
+        }
+
+        strength_t strengths[LOG_PLAYERS * BATCH_SIZE];
+        evaluate_batch(cards[0], HAND_SIZE, LOG_PLAYERS * BATCH_SIZE, strengths);
+        for (int deal = 0; deal < size; ++deal) {
+            strength_t first = strengths[deal];
+            strength_t second = strengths[BATCH_SIZE + deal];
+            ++stats.lines;
+            ++stats.categories[0][category(first)];
+            ++stats.categories[1][category(second)];
+            if (first > second) {
+                ++stats.wins[0];
+            } else if (second > first) {
+                ++stats.wins[1];
+            } else {
+                ++stats.ties;
+            }
+        }
+        size = 0;
+    }
+
+private:
+    card_t cards[HAND_SIZE][LOG_PLAYERS * BATCH_SIZE] = {{0}};
+    int size = 0;
+};
+
+void tally_lines(const char *begin, const char *end, LogStats &stats) {
+    DealBatch batch;
+    card_t deal[LOG_PLAYERS * HAND_SIZE];
+    while (begin < end) {
+        const char *newline = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+        const char *line_end = newline ? newline : end;
+        int found = parse_line(begin, line_end, deal);
+        if (found == -1) {
+            ++stats.bad_lines;
+        } else if (found != 0) {
+            batch.add(deal, stats);
+        }
+        begin = line_end + 1;
+    }
+    batch.settle(stats);
+}
+
+/* Chunk starts, each one just past a newline. Last entry is the end of data. */
+std::vector<const char *> split_lines(const char *begin, const char *end, std::size_t chunks) {
+    std::vector<const char *> bounds = {begin};
+    const std::size_t step = std::max(MIN_CHUNK, (end - begin) / std::max<std::size_t>(1, chunks));
+
+    const char *cur = begin;
+    while (end - cur > static_cast<std::ptrdiff_t>(step)) {
+        cur += step;
+        const char *newline = static_cast<const char *>(std::memchr(cur, '\n', end - cur));
+        if (newline == NULL) {
+            break;
+        }
+        cur = newline + 1;
+        bounds.push_back(cur);
+    }
+    if (bounds.back() != end) {
+        bounds.push_back(end);
+    }
+
+    return bounds;
+}
+
+LogStats tally_log(const std::string &filename, unsigned threads) {
+    MappedFile file(filename);
+    file.advise_sequential();
+
+    threads = threads ? threads : std::thread::hardware_concurrency();
+    threads = std::max(1u, threads);
+    std::vector<const char *> bounds = split_lines(file.begin(), file.end(),
+            threads * CHUNKS_PER_THREAD);
+    const std::size_t num_chunks = bounds.size() - 1;
+    threads = std::min<std::size_t>(threads, std::max<std::size_t>(1, num_chunks));
+
+    std::vector<LogStats> stats(threads);
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> next_chunk(0);
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&bounds, &next_chunk, &stats, num_chunks, t]() {
+            // Tally on the stack, neighbouring stats would share cache lines.
+            LogStats local;
+            std::size_t chunk;
+            while ((chunk = next_chunk.fetch_add(1)) < num_chunks) {
+                tally_lines(bounds[chunk], bounds[chunk + 1], local);
+            }
+            stats[t] = local;
+        }));
+    }
+
+    LogStats total;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers[t].join();
+        total.merge(stats[t]);
+    }
+
+    return total;
+}
+
+} /* end util::poker */
+
+} /* end util:: */
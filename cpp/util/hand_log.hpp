@@ -0,0 +1,46 @@
+#ifndef _HAND_LOG_HPP_
+#define _HAND_LOG_HPP_
+
+/********************* Header Files ***********************/
+#include <cstdint>
+#include <string>
+
+#include "poker.hpp"
+
+namespace util {
+
+namespace poker {
+
+/******************* Constants/Macros *********************/
+static const int LOG_PLAYERS = 2;
+
+/************** Class & Func Declarations *****************/
+// Totals over a hand log, one line per deal: 5 cards for player 1 then 5 for player 2.
+class LogStats {
+public:
+    void merge(const LogStats &other);
+
+    // Data
+    std::uint64_t lines = 0;
+    // Lines without exactly 10 cards, skipped. Blank lines aren't counted at all.
+    std::uint64_t bad_lines = 0;
+    std::uint64_t wins[LOG_PLAYERS] = {0};
+    std::uint64_t ties = 0;
+    // Count of each Category per player.
+    std::uint64_t categories[LOG_PLAYERS][NUM_CATEGORIES] = {{0}};
+};
+
+/* Settle every complete line in [begin, end) into stats. */
+void tally_lines(const char *begin, const char *end, LogStats &stats);
+
+/*
+ * Memory map the log, split it into chunks on line boundaries & tally the
+ * chunks on threads (0 uses all hardware threads). Per thread stats merge at the end.
+ */
+LogStats tally_log(const std::string &filename, unsigned threads = 0);
+
+} /* end util::poker */
+
+} /* end util:: */
+
+#endif /* _HAND_LOG_HPP_ */
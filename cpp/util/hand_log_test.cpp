@@ -0,0 +1,76 @@
+/**
+ * Test cases for the chunked hand log processor
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <fstream>
+#include <cstdio>
+
+#include "gtest/gtest.h"
+#include "hand_log.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+namespace poker = util::poker;
+
+/************** Global Vars & Functions *******************/
+static const std::string LOG_FNAME = "/tmp/util_hand_log_test.txt";
+static const std::string LOG_LINES =
+    "5H 5C 6S 7S KD 2C 3S 8S 8D TD\n"
+    "5D 8C 9S JS AC 2C 5C 7D 8S QH\r\n"
+    "\n"
+    "2D 9C AS AH AC 3D 6D 7D TD QD\n"
+    "4D 6S 9H QH QC 3D 6D 7H QD QS\n"
+    "2H 2D 4S 4C KC 2C 2S 4H 4D KH\n"
+    "2H 2D 4S 4C KC 2C 2S 4H\n"
+    "2H 2D 4S 4C KC 2C 2S 4H 4D 1H\n"
+    "2C 3C 4C 5C 7D 8H 8D 8C 8S 2S";
+
+TEST(UtilHandLog, TallyLines) {
+    poker::LogStats stats;
+    poker::tally_lines(LOG_LINES.data(), LOG_LINES.data() + LOG_LINES.size(), stats);
+    ASSERT_EQ(stats.lines, 6);
+    ASSERT_EQ(stats.bad_lines, 2);
+    ASSERT_EQ(stats.wins[0], 2);
+    ASSERT_EQ(stats.wins[1], 3);
+    ASSERT_EQ(stats.ties, 1);
+    ASSERT_EQ(stats.categories[0][poker::TwoPair], 1);
+    ASSERT_EQ(stats.categories[1][poker::Flush], 1);
+    ASSERT_EQ(stats.categories[1][poker::FourKind], 1);
+}
+
+TEST(UtilHandLog, Merge) {
+    poker::LogStats stats, other;
+    poker::tally_lines(LOG_LINES.data(), LOG_LINES.data() + LOG_LINES.size(), stats);
+    poker::tally_lines(LOG_LINES.data(), LOG_LINES.data() + LOG_LINES.size(), other);
+    stats.merge(other);
+    ASSERT_EQ(stats.lines, 12);
+    ASSERT_EQ(stats.wins[1], 6);
+    ASSERT_EQ(stats.categories[1][poker::FourKind], 2);
+}
+
+TEST(UtilHandLog, TallyLogThreads) {
+    // Big enough to split into many chunks.
+    {
+        std::ofstream fout(LOG_FNAME);
+        for (int i = 0; i < 20000; ++i) {
+            fout << LOG_LINES << "\n";
+        }
+    }
+
+    poker::LogStats single = poker::tally_log(LOG_FNAME, 1);
+    ASSERT_EQ(single.lines, 6 * 20000);
+    ASSERT_EQ(single.bad_lines, 2 * 20000);
+    for (unsigned threads : {2, 3, 8}) {
+        poker::LogStats stats = poker::tally_log(LOG_FNAME, threads);
+        ASSERT_EQ(stats.lines, single.lines);
+        ASSERT_EQ(stats.bad_lines, single.bad_lines);
+        ASSERT_EQ(stats.wins[0], single.wins[0]);
+        ASSERT_EQ(stats.wins[1], single.wins[1]);
+        ASSERT_EQ(stats.ties, single.ties);
+        ASSERT_EQ(stats.categories[1][poker::Flush], single.categories[1][poker::Flush]);
+    }
+    std::remove(LOG_FNAME.c_str());
+}
@@ -0,0 +1,58 @@
+/**
+ * Thin RAII wrapper over POSIX mmap for read only files.
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+/* C Headers */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mapped_file.hpp"
+
+namespace util {
+
+/************** Global Vars & Functions *******************/
+MappedFile::MappedFile(const std::string &filename) : addr(NULL), length(0) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Unable to open " + filename + ": " + std::strerror(errno));
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) == -1) {
+        ::close(fd);
+        throw std::runtime_error("Unable to stat " + filename + ": " + std::strerror(errno));
+    }
+    length = info.st_size;
+
+    // Zero length maps are invalid, an empty file is just an empty range.
+    if (length != 0) {
+        void *mapped = ::mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Unable to map " + filename + ": " + std::strerror(errno));
+        }
+        addr = static_cast<const char *>(mapped);
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (addr != NULL) {
+        ::munmap(const_cast<char *>(addr), length);
+    }
+}
+
+void MappedFile::advise_sequential() const {
+    if (addr != NULL) {
+        ::madvise(const_cast<char *>(addr), length, MADV_SEQUENTIAL);
+    }
+}
+
+} /* end util:: */
@@ -0,0 +1,38 @@
+#ifndef _MAPPED_FILE_HPP_
+#define _MAPPED_FILE_HPP_
+
+/********************* Header Files ***********************/
+#include <cstddef>
+#include <string>
+
+namespace util {
+
+/************** Class & Func Declarations *****************/
+/*
+ * Read only memory map of a whole file, unmapped on destruction.
+ * Throws std::runtime_error if the file can't be opened or mapped.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &filename);
+    ~MappedFile();
+    MappedFile(const MappedFile &other) = delete;
+    MappedFile & operator=(const MappedFile &other) = delete;
+
+    // Hint the kernel the file will be read front to back.
+    void advise_sequential() const;
+
+    const char * data() const { return addr; }
+    const char * begin() const { return addr; }
+    const char * end() const { return addr + length; }
+    std::size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+private:
+    const char *addr;
+    std::size_t length;
+};
+
+} /* end util:: */
+
+#endif /* _MAPPED_FILE_HPP_ */
@@ -0,0 +1,39 @@
+/**
+ * Test cases for the memory mapped file wrapper
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <fstream>
+#include <stdexcept>
+#include <cstdio>
+
+#include "gtest/gtest.h"
+#include "mapped_file.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+
+/************** Global Vars & Functions *******************/
+static const std::string MAPPED_FNAME = "/tmp/util_mapped_file_test.txt";
+
+TEST(UtilMappedFile, ReadContents) {
+    std::ofstream(MAPPED_FNAME) << "8C TS KC 9H 4S\n";
+    util::MappedFile file(MAPPED_FNAME);
+    ASSERT_EQ(file.size(), 15);
+    ASSERT_EQ(std::string(file.begin(), file.end()), "8C TS KC 9H 4S\n");
+    std::remove(MAPPED_FNAME.c_str());
+}
+
+TEST(UtilMappedFile, EmptyFile) {
+    std::ofstream(MAPPED_FNAME).close();
+    util::MappedFile file(MAPPED_FNAME);
+    ASSERT_TRUE(file.empty());
+    ASSERT_EQ(file.begin(), file.end());
+    std::remove(MAPPED_FNAME.c_str());
+}
+
+TEST(UtilMappedFile, Missing) {
+    ASSERT_THROW(util::MappedFile("/tmp/util_no_such_file.txt"), std::runtime_error);
+}
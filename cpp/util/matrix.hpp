@@ -0,0 +1,155 @@
+#ifndef _MATRIX_HPP_
+#define _MATRIX_HPP_
+
+/********************* Header Files ***********************/
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+/******************* Constants/Macros *********************/
+// Moves between neighboring cells, combine them into a mask.
+static const unsigned MOVE_UP = 1;
+static const unsigned MOVE_RIGHT = 2;
+static const unsigned MOVE_DOWN = 4;
+static const unsigned MOVE_LEFT = 8;
+static const unsigned MOVES_TWO = MOVE_RIGHT | MOVE_DOWN;
+static const unsigned MOVES_THREE = MOVE_UP | MOVE_RIGHT | MOVE_DOWN;
+static const unsigned MOVES_FOUR = MOVE_UP | MOVE_RIGHT | MOVE_DOWN | MOVE_LEFT;
+
+/************** Class & Func Declarations *****************/
+/*
+ * Rectangular grid stored contiguously in row major order.
+ * Cells are named by flat index, row * cols() + col, so per cell
+ * DP values can live in a plain side array of size() entries.
+ */
+template <class T>
+class Matrix {
+public:
+    Matrix(std::size_t rows = 0, std::size_t cols = 0, const T &fill = T()) :
+            num_rows(rows), num_cols(cols), cells(rows * cols, fill) {}
+    /* Takes the row major cells, throws std::invalid_argument unless rows * cols of them. */
+    Matrix(std::size_t rows, std::size_t cols, std::vector<T> &&values) :
+            num_rows(rows), num_cols(cols), cells(std::move(values)) {
+        if (cells.size() != rows * cols) {
+            throw std::invalid_argument("Matrix needs rows * cols cells.");
+        }
+    }
+
+    T & operator()(std::size_t row, std::size_t col) { return cells[row * num_cols + col]; }
+    const T & operator()(std::size_t row, std::size_t col) const { return cells[row * num_cols + col]; }
+    T & operator[](std::size_t index) { return cells[index]; }
+    const T & operator[](std::size_t index) const { return cells[index]; }
+    T * row(std::size_t row) { return cells.data() + row * num_cols; }
+    const T * row(std::size_t row) const { return cells.data() + row * num_cols; }
+    T * data() { return cells.data(); }
+    const T * data() const { return cells.data(); }
+
+    std::size_t rows() const { return num_rows; }
+    std::size_t cols() const { return num_cols; }
+    std::size_t size() const { return cells.size(); }
+    bool empty() const { return cells.empty(); }
+    std::size_t index(std::size_t row, std::size_t col) const { return row * num_cols + col; }
+    std::size_t row_of(std::size_t index) const { return index / num_cols; }
+    std::size_t col_of(std::size_t index) const { return index % num_cols; }
+    /* Reshape to rows x cols keeping the memory already held, cell values are left unspecified. */
+    void resize(std::size_t rows, std::size_t cols) {
+        num_rows = rows;
+        num_cols = cols;
+        cells.resize(rows * cols);
+    }
+    /* Hand back the cells, leaving the matrix empty, so their memory can be reused. */
+    std::vector<T> release() {
+        num_rows = num_cols = 0;
+        return std::move(cells);
+    }
+
+    /* Call visit(neighbor) for each neighbor of index reachable by moves, in up, right, down, left order. */
+    template <class Visit>
+    void for_neighbors(std::size_t index, unsigned moves, Visit visit) const {
+        const std::size_t col = index % num_cols;
+        if ((moves & MOVE_UP) && index >= num_cols) {
+            visit(index - num_cols);
+        }
+        if ((moves & MOVE_RIGHT) && col + 1 < num_cols) {
+            visit(index + 1);
+        }
+        if ((moves & MOVE_DOWN) && index + num_cols < cells.size()) {
+            visit(index + num_cols);
+        }
+        if ((moves & MOVE_LEFT) && col > 0) {
+            visit(index - 1);
+        }
+    }
+
+private:
+    std::size_t num_rows;
+    std::size_t num_cols;
+    std::vector<T> cells;
+};
+
+/*
+ * Print index as "Node: value(a, b)", a, b... being its neighbor values for each move
+ * in moves, in up, right, down, left order, with 0 where a neighbor is off the grid.
+ */
+template <class T>
+void print_cell(std::ostream &os, const Matrix<T> &matrix, std::size_t index, unsigned moves) {
+    const std::size_t row = matrix.row_of(index), col = matrix.col_of(index);
+    const std::pair<unsigned, T> neighbors[] = {
+        std::make_pair(MOVE_UP, row > 0 ? matrix[index - matrix.cols()] : T()),
+        std::make_pair(MOVE_RIGHT, col + 1 < matrix.cols() ? matrix[index + 1] : T()),
+        std::make_pair(MOVE_DOWN, row + 1 < matrix.rows() ? matrix[index + matrix.cols()] : T()),
+        std::make_pair(MOVE_LEFT, col > 0 ? matrix[index - 1] : T()),
+    };
+    const char *sep = "";
+    os << "Node: " << matrix[index] << "(";
+    for (const std::pair<unsigned, T> &neighbor : neighbors) {
+        if (moves & neighbor.first) {
+            os << sep << neighbor.second;
+            sep = ", ";
+        }
+    }
+    os << ")";
+}
+
+/*
+ * Triangle with row r holding r + 1 cells, stored contiguously row after row.
+ * Below (row, col) are (row + 1, col) & (row + 1, col + 1).
+ */
+template <class T>
+class Triangle {
+public:
+    explicit Triangle(std::size_t rows = 0, const T &fill = T()) :
+            num_rows(rows), cells(rows * (rows + 1) / 2, fill) {}
+    /* Takes the cells row after row, throws std::invalid_argument unless they fill rows. */
+    Triangle(std::size_t rows, std::vector<T> &&values) : num_rows(rows), cells(std::move(values)) {
+        if (cells.size() != rows * (rows + 1) / 2) {
+            throw std::invalid_argument("Triangle needs rows * (rows + 1) / 2 cells.");
+        }
+    }
+
+    T & operator()(std::size_t row, std::size_t col) { return cells[index(row, col)]; }
+    const T & operator()(std::size_t row, std::size_t col) const { return cells[index(row, col)]; }
+    T & operator[](std::size_t index) { return cells[index]; }
+    const T & operator[](std::size_t index) const { return cells[index]; }
+    T * row(std::size_t row) { return cells.data() + index(row, 0); }
+    const T * row(std::size_t row) const { return cells.data() + index(row, 0); }
+    T * data() { return cells.data(); }
+    const T * data() const { return cells.data(); }
+
+    std::size_t rows() const { return num_rows; }
+    std::size_t size() const { return cells.size(); }
+    bool empty() const { return cells.empty(); }
+    std::size_t index(std::size_t row, std::size_t col) const { return row * (row + 1) / 2 + col; }
+
+private:
+    std::size_t num_rows;
+    std::vector<T> cells;
+};
+
+} /* end util:: */
+
+#endif /* _MATRIX_HPP_ */
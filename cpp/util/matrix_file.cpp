@@ -0,0 +1,195 @@
+/**
+ * Parse grids & triangles of integers straight from mapped files.
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+#include "mapped_file.hpp"
+#include "matrix_file.hpp"
+
+namespace util {
+
+/************** Global Vars & Functions *******************/
+inline bool is_blank(char letter) {
+    return letter == ' ' || letter == '\t' || letter == '\r';
+}
+
+inline const char * end_of_line(const char *pos, const char *end) {
+    const char *eol = static_cast<const char *>(std::memchr(pos, '\n', end - pos));
+    return eol == NULL ? end : eol;
+}
+
+/* The first line with anything but blanks on it. */
+const char * first_line(const char *text, const char *end, const char *&eol) {
+    const char *pos = text;
+    while (pos < end) {
+        eol = end_of_line(pos, end);
+        if (std::find_if(pos, eol, [](char letter) { return !is_blank(letter); }) != eol) {
+            return pos;
+        }
+        pos = eol + 1;
+    }
+    eol = end;
+
+    return end;
+}
+
+char detect_separator(const char *text, std::size_t size) {
+    const char *eol;
+    const char *line = first_line(text, text + size, eol);
+    return std::find(line, eol, ',') != eol ? ',' : ' ';
+}
+
+/* Append the values on [pos, eol) to values & return how many, see parse_rows. */
+std::size_t parse_line(const char *pos, const char *eol, char sep, std::vector<int> &values) {
+    std::size_t count = 0;
+    bool want_value = true;
+    while (true) {
+        while (pos != eol && is_blank(*pos)) {
+            ++pos;
+        }
+        if (pos == eol) {
+            if (count != 0 && want_value && sep == ',') {
+                throw std::runtime_error("Empty field at the end of a matrix row.");
+            }
+            break;
+        } else if (!want_value) {
+            // Comma mode only, a value was just read & the comma must follow.
+            if (*pos != ',') {
+                throw std::runtime_error("Expected a comma between matrix values.");
+            }
+            ++pos;
+            want_value = true;
+            continue;
+        }
+
+        int value;
+        std::from_chars_result result = std::from_chars(pos, eol, value);
+        if (result.ec != std::errc() || (sep == ' ' && result.ptr != eol && !is_blank(*result.ptr))) {
+            throw std::runtime_error("Malformed number in matrix text.");
+        }
+        values.push_back(value);
+        ++count;
+        pos = result.ptr;
+        want_value = sep != ',';
+    }
+
+    return count;
+}
+
+void parse_rows(const char *text, std::size_t size, std::vector<int> &values,
+        std::vector<std::size_t> &lengths) {
+    const char *end = text + size;
+    const char sep = detect_separator(text, size);
+
+    // Every line is about as long as the first, so reserve for all of them up front.
+    const char *eol;
+    const char *line = first_line(text, end, eol);
+    std::size_t per_line = 0;
+    for (const char *pos = line; pos != eol; ++pos) {
+        per_line += sep == ',' ? *pos == ',' : !is_blank(*pos) && (pos == line || is_blank(pos[-1]));
+    }
+    per_line += sep == ',';
+    const std::size_t lines = std::count(text, end, '\n') + 1;
+    values.reserve(values.size() + lines * per_line);
+    lengths.reserve(lengths.size() + lines);
+
+    for (const char *pos = text; pos < end; pos = eol + 1) {
+        eol = end_of_line(pos, end);
+        std::size_t count = parse_line(pos, eol, sep, values);
+        if (count != 0) {
+            lengths.push_back(count);
+        }
+    }
+}
+
+Matrix<int> parse_matrix(const char *text, std::size_t size) {
+    return parse_matrix(text, size, std::vector<int>());
+}
+
+Matrix<int> parse_matrix(const char *text, std::size_t size, std::vector<int> &&buffer) {
+    std::vector<int> values(std::move(buffer));
+    std::vector<std::size_t> lengths;
+    values.clear();
+    parse_rows(text, size, values, lengths);
+    if (std::any_of(lengths.begin(), lengths.end(),
+                [&lengths](std::size_t length) { return length != lengths.front(); })) {
+        throw std::runtime_error("Matrix rows must all be the same length.");
+    }
+
+    const std::size_t rows = lengths.size();
+    return Matrix<int>(rows, rows ? lengths.front() : 0, std::move(values));
+}
+
+Triangle<int> parse_triangle(const char *text, std::size_t size) {
+    std::vector<int> values;
+    std::vector<std::size_t> lengths;
+    const std::size_t lines = std::count(text, text + size, '\n') + 1;
+    values.reserve(lines * (lines + 1) / 2);
+    parse_rows(text, size, values, lengths);
+    for (std::size_t row = 0; row < lengths.size(); ++row) {
+        if (lengths[row] != row + 1) {
+            throw std::runtime_error("Triangle row r must have r + 1 values.");
+        }
+    }
+
+    return Triangle<int>(lengths.size(), std::move(values));
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> split_blocks(const char *text, std::size_t size) {
+    std::vector<std::pair<std::size_t, std::size_t>> blocks;
+    const char *end = text + size;
+    const char *begin = NULL;
+    for (const char *pos = text, *eol; pos < end; pos = eol + 1) {
+        eol = end_of_line(pos, end);
+        const bool blank = std::all_of(pos, eol, is_blank);
+        if (!blank && begin == NULL) {
+            begin = pos;
+        } else if (blank && begin != NULL) {
+            blocks.push_back(std::make_pair(begin - text, pos - text));
+            begin = NULL;
+        }
+    }
+    if (begin != NULL) {
+        blocks.push_back(std::make_pair(begin - text, size));
+    }
+
+    return blocks;
+}
+
+Matrix<int> load_matrix(const std::string &filename) {
+    MappedFile file(filename);
+    file.advise_sequential();
+    return parse_matrix(file.data(), file.size());
+}
+
+Triangle<int> load_triangle(const std::string &filename) {
+    MappedFile file(filename);
+    file.advise_sequential();
+    return parse_triangle(file.data(), file.size());
+}
+
+RowReader::RowReader(const std::string &filename) : file(filename),
+        pos(file.begin()), sep(detect_separator(file.data(), file.size())) {
+    file.advise_sequential();
+}
+
+bool RowReader::next(std::vector<int> &row) {
+    row.clear();
+    while (pos < file.end()) {
+        const char *eol = end_of_line(pos, file.end());
+        const std::size_t count = parse_line(pos, eol, sep, row);
+        pos = eol + 1;
+        if (count != 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} /* end util:: */
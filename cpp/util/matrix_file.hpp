@@ -0,0 +1,61 @@
+#ifndef _MATRIX_FILE_HPP_
+#define _MATRIX_FILE_HPP_
+
+/********************* Header Files ***********************/
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mapped_file.hpp"
+#include "matrix.hpp"
+
+namespace util {
+
+/************** Class & Func Declarations *****************/
+/* ',' if the first line of text has a comma, else ' ' standing for any spaces or tabs. */
+char detect_separator(const char *text, std::size_t size);
+
+/*
+ * Append the integers of text to values, one row per line with blank lines
+ * skipped, & each row's count to lengths. The separator is detected, in comma
+ * mode spaces around a comma are allowed but an empty field is not.
+ * Throws std::runtime_error on anything else.
+ */
+void parse_rows(const char *text, std::size_t size, std::vector<int> &values,
+        std::vector<std::size_t> &lengths);
+
+/* Rows as parse_rows reads them, throws std::runtime_error unless all are as long as the first. */
+Matrix<int> parse_matrix(const char *text, std::size_t size);
+/* As above but the cells go in buffer, cleared first, to reuse its memory. */
+Matrix<int> parse_matrix(const char *text, std::size_t size, std::vector<int> &&buffer);
+/* Rows as parse_rows reads them, throws std::runtime_error unless row r has r + 1 values. */
+Triangle<int> parse_triangle(const char *text, std::size_t size);
+
+/* [begin, end) offsets of each run of non blank lines in text, i.e. each of several matrices. */
+std::vector<std::pair<std::size_t, std::size_t>> split_blocks(const char *text, std::size_t size);
+
+/* Map filename & parse it, also throws std::runtime_error if it can't be read. */
+Matrix<int> load_matrix(const std::string &filename);
+Triangle<int> load_triangle(const std::string &filename);
+
+/*
+ * Map filename & parse it one row at a time, parsed like parse_rows but only
+ * the current row is ever held. Throws std::runtime_error as parse_rows does.
+ */
+class RowReader {
+public:
+    explicit RowReader(const std::string &filename);
+
+    /* Replace row with the values of the next non blank line, false once there are none. */
+    bool next(std::vector<int> &row);
+
+private:
+    MappedFile file;
+    const char *pos;
+    char sep;
+};
+
+} /* end util:: */
+
+#endif /* _MATRIX_FILE_HPP_ */
@@ -0,0 +1,117 @@
+/**
+ * Test cases for the matrix & triangle file parser
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <cstdio>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "matrix_file.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+
+/************** Global Vars & Functions *******************/
+static const std::string MATRIX_FNAME = "/tmp/util_matrix_file_test.txt";
+
+util::Matrix<int> parse(const std::string &text) {
+    return util::parse_matrix(text.data(), text.size());
+}
+
+TEST(UtilMatrixFile, DetectSeparator) {
+    std::string comma = "\n131,673\n201,96\n";
+    std::string space = "08 02 22\n49 49 99";
+    ASSERT_EQ(util::detect_separator(comma.data(), comma.size()), ',');
+    ASSERT_EQ(util::detect_separator(space.data(), space.size()), ' ');
+}
+
+TEST(UtilMatrixFile, ParseMatrix) {
+    util::Matrix<int> comma = parse("131,673,234\r\n201, 96 ,342\r\n\r\n");
+    ASSERT_EQ(comma.rows(), 2);
+    ASSERT_EQ(comma.cols(), 3);
+    ASSERT_EQ(comma(1, 1), 96);
+    ASSERT_EQ(comma(1, 2), 342);
+
+    util::Matrix<int> space = parse("08 02\t22\n 49 -49 99");
+    ASSERT_EQ(space.cols(), 3);
+    ASSERT_EQ(space(0, 0), 8);
+    ASSERT_EQ(space(1, 1), -49);
+
+    ASSERT_TRUE(parse("").empty());
+}
+
+TEST(UtilMatrixFile, Malformed) {
+    ASSERT_THROW(parse("1,2,3\n4,5"), std::runtime_error);
+    ASSERT_THROW(parse("1,,3"), std::runtime_error);
+    ASSERT_THROW(parse("1,2,"), std::runtime_error);
+    ASSERT_THROW(parse("1 2\n3,4"), std::runtime_error);
+    ASSERT_THROW(parse("1 2x"), std::runtime_error);
+    ASSERT_THROW(parse("1,2 3"), std::runtime_error);
+    ASSERT_THROW(parse("99999999999"), std::runtime_error);
+}
+
+TEST(UtilMatrixFile, SplitBlocks) {
+    std::string text = "\n1,2\r\n3,4\n \r\n\n5 6\n7 8";
+    std::vector<std::pair<std::size_t, std::size_t>> blocks = util::split_blocks(text.data(), text.size());
+    ASSERT_EQ(blocks.size(), 2);
+    ASSERT_EQ(text.substr(blocks[0].first, blocks[0].second - blocks[0].first), "1,2\r\n3,4\n");
+    ASSERT_EQ(text.substr(blocks[1].first), "5 6\n7 8");
+    ASSERT_EQ(blocks[1].second, text.size());
+    ASSERT_TRUE(util::split_blocks("\n \n", 3).empty());
+}
+
+TEST(UtilMatrixFile, ParseTriangle) {
+    std::string text = "75\n95 64\n17 47 82\n";
+    util::Triangle<int> triangle = util::parse_triangle(text.data(), text.size());
+    ASSERT_EQ(triangle.rows(), 3);
+    ASSERT_EQ(triangle(2, 1), 47);
+
+    std::string bad = "75\n95\n";
+    ASSERT_THROW(util::parse_triangle(bad.data(), bad.size()), std::runtime_error);
+}
+
+TEST(UtilMatrixFile, LoadLarge) {
+    static const int side = 1000;
+    {
+        std::ofstream fout(MATRIX_FNAME);
+        for (int row = 0; row < side; ++row) {
+            for (int col = 0; col < side; ++col) {
+                fout << (row * 7919 + col * 104729) % 10000 << (col + 1 == side ? "\n" : ",");
+            }
+        }
+    }
+
+    util::Matrix<int> matrix = util::load_matrix(MATRIX_FNAME);
+    ASSERT_EQ(matrix.rows(), side);
+    ASSERT_EQ(matrix.cols(), side);
+    ASSERT_EQ(matrix(999, 998), (999 * 7919 + 998 * 104729) % 10000);
+
+    std::remove(MATRIX_FNAME.c_str());
+    ASSERT_THROW(util::load_matrix(MATRIX_FNAME), std::runtime_error);
+}
+
+TEST(UtilMatrixFile, RowReader) {
+    {
+        std::ofstream fout(MATRIX_FNAME);
+        fout << "131, 673,234\r\n\r\n201,96,342\n18,3,1";
+    }
+
+    util::RowReader reader(MATRIX_FNAME);
+    std::vector<int> row;
+    ASSERT_TRUE(reader.next(row));
+    ASSERT_EQ(row, std::vector<int>({131, 673, 234}));
+    ASSERT_TRUE(reader.next(row));
+    ASSERT_EQ(row, std::vector<int>({201, 96, 342}));
+    ASSERT_TRUE(reader.next(row));
+    ASSERT_EQ(row, std::vector<int>({18, 3, 1}));
+    ASSERT_FALSE(reader.next(row));
+    ASSERT_TRUE(row.empty());
+
+    std::remove(MATRIX_FNAME.c_str());
+}
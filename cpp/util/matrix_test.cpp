@@ -0,0 +1,84 @@
+/**
+ * Test cases for the flat matrix & triangle
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "matrix.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+
+/************** Global Vars & Functions *******************/
+TEST(UtilMatrix, Access) {
+    util::Matrix<int> matrix(2, 3, 7);
+    ASSERT_EQ(matrix.size(), 6);
+    ASSERT_EQ(matrix(1, 2), 7);
+
+    matrix(1, 2) = 5;
+    ASSERT_EQ(matrix[matrix.index(1, 2)], 5);
+    ASSERT_EQ(matrix.row(1)[2], 5);
+    ASSERT_EQ(matrix.row_of(5), 1);
+    ASSERT_EQ(matrix.col_of(5), 2);
+
+    util::Matrix<int> moved(2, 2, std::vector<int>({1, 2, 3, 4}));
+    ASSERT_EQ(moved(1, 0), 3);
+    ASSERT_THROW(util::Matrix<int>(2, 2, std::vector<int>({1, 2, 3})), std::invalid_argument);
+
+    std::vector<int> cells = moved.release();
+    ASSERT_EQ(cells, std::vector<int>({1, 2, 3, 4}));
+    ASSERT_TRUE(moved.empty());
+    ASSERT_EQ(moved.rows(), 0);
+}
+
+TEST(UtilMatrix, Neighbors) {
+    util::Matrix<int> matrix(3, 3);
+    std::vector<std::size_t> seen;
+    auto visit = [&seen](std::size_t index) { seen.push_back(index); };
+
+    matrix.for_neighbors(4, util::MOVES_FOUR, visit);
+    ASSERT_EQ(seen, std::vector<std::size_t>({1, 5, 7, 3}));
+
+    seen.clear();
+    matrix.for_neighbors(0, util::MOVES_FOUR, visit);
+    ASSERT_EQ(seen, std::vector<std::size_t>({1, 3}));
+
+    seen.clear();
+    matrix.for_neighbors(5, util::MOVES_THREE, visit);
+    ASSERT_EQ(seen, std::vector<std::size_t>({2, 8}));
+
+    seen.clear();
+    matrix.for_neighbors(8, util::MOVES_TWO, visit);
+    ASSERT_TRUE(seen.empty());
+}
+
+TEST(UtilMatrix, PrintCell) {
+    util::Matrix<int> matrix(2, 3, std::vector<int>({1, 2, 3, 4, 5, 6}));
+    std::stringstream ss;
+    util::print_cell(ss, matrix, 1, util::MOVES_FOUR);
+    ASSERT_EQ(ss.str(), "Node: 2(0, 3, 5, 1)");
+
+    ss.str("");
+    util::print_cell(ss, matrix, 5, util::MOVES_TWO);
+    ASSERT_EQ(ss.str(), "Node: 6(0, 0)");
+}
+
+TEST(UtilMatrix, Triangle) {
+    util::Triangle<int> triangle(3, std::vector<int>({1, 2, 3, 4, 5, 6}));
+    ASSERT_EQ(triangle.rows(), 3);
+    ASSERT_EQ(triangle(0, 0), 1);
+    ASSERT_EQ(triangle(1, 1), 3);
+    ASSERT_EQ(triangle(2, 0), 4);
+    ASSERT_EQ(triangle.row(2)[2], 6);
+    ASSERT_THROW(util::Triangle<int>(3, std::vector<int>({1, 2})), std::invalid_argument);
+
+    util::Triangle<int> empty(4, -1);
+    ASSERT_EQ(empty.size(), 10);
+    ASSERT_EQ(empty(3, 3), -1);
+}
@@ -0,0 +1,150 @@
+#ifndef _PARALLEL_HPP_
+#define _PARALLEL_HPP_
+
+/********************* Header Files ***********************/
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace util {
+
+/************** Class & Func Declarations *****************/
+/* Workers parallel_for will run for count tasks, threads 0 means all hardware threads. */
+inline unsigned worker_count(unsigned threads, std::size_t count) {
+    threads = threads ? threads : std::thread::hardware_concurrency();
+    threads = std::min<std::size_t>(std::max(1u, threads), std::max<std::size_t>(1, count));
+
+    return threads;
+}
+
+/*
+ * Call task(index, worker) for every index in [0, count) across worker_count()
+ * workers, the caller being worker 0. Indices are claimed one at a time from a
+ * shared counter so uneven tasks balance out. Per worker state can be indexed
+ * by worker without locking. Tasks must not throw.
+ */
+template <class Task>
+void parallel_for(std::size_t count, unsigned threads, Task task) {
+    const unsigned workers = worker_count(threads, count);
+    std::atomic<std::size_t> next(0);
+    auto work = [&next, &task, count](unsigned worker) {
+        std::size_t index;
+        while ((index = next.fetch_add(1)) < count) {
+            task(index, worker);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned worker = 1; worker < workers; ++worker) {
+        pool.push_back(std::thread(work, worker));
+    }
+    work(0);
+    for (std::thread &thread : pool) {
+        thread.join();
+    }
+}
+
+/*
+ * Workers started once & reused by every run, for callers with many short
+ * parallel loops where parallel_for starting threads each call would dominate.
+ */
+class WorkerPool {
+public:
+    /* threads 0 means all hardware threads. */
+    explicit WorkerPool(unsigned threads = 0) :
+            workers(worker_count(threads, std::numeric_limits<std::size_t>::max())) {
+        for (unsigned worker = 1; worker < workers; ++worker) {
+            pool.push_back(std::thread(&WorkerPool::loop, this, worker));
+        }
+    }
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread &thread : pool) {
+            thread.join();
+        }
+    }
+    WorkerPool(const WorkerPool &other) = delete;
+    WorkerPool & operator=(const WorkerPool &other) = delete;
+
+    unsigned size() const { return workers; }
+
+    /* As parallel_for across the pool, the caller being worker 0. Returns once every task ran. */
+    template <class Task>
+    void run(std::size_t count, Task task) {
+        if (workers == 1 || count <= 1) {
+            for (std::size_t index = 0; index < count; ++index) {
+                task(index, 0);
+            }
+            return;
+        }
+
+        std::function<void(std::size_t, unsigned)> job(std::ref(task));
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current = &job;
+            total = count;
+            next.store(0);
+            busy = workers - 1;
+            ++generation;
+        }
+        wake.notify_all();
+        work(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return busy == 0; });
+        current = NULL;
+    }
+
+private:
+    void work(unsigned worker) {
+        std::size_t index;
+        while ((index = next.fetch_add(1)) < total) {
+            (*current)(index, worker);
+        }
+    }
+    // Every worker joins every run, so run can't start another until all have finished this one.
+    void loop(unsigned worker) {
+        unsigned long seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+            }
+            work(worker);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --busy;
+            }
+            done.notify_one();
+        }
+    }
+
+    const unsigned workers;
+    std::vector<std::thread> pool;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(std::size_t, unsigned)> *current = NULL;
+    std::size_t total = 0;
+    std::atomic<std::size_t> next{0};
+    unsigned busy = 0;
+    unsigned long generation = 0;
+    bool stopping = false;
+};
+
+} /* end util:: */
+
+#endif /* _PARALLEL_HPP_ */
@@ -0,0 +1,65 @@
+/**
+ * Test cases for the parallel loop helper
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <algorithm>
+#include <numeric>
+
+#include "gtest/gtest.h"
+#include "parallel.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+
+/************** Global Vars & Functions *******************/
+TEST(UtilParallel, WorkerCount) {
+    ASSERT_EQ(util::worker_count(4, 100), 4);
+    ASSERT_EQ(util::worker_count(4, 2), 2);
+    ASSERT_EQ(util::worker_count(4, 0), 1);
+    ASSERT_GE(util::worker_count(0, 100), 1);
+}
+
+TEST(UtilParallel, EveryIndexOnce) {
+    const std::size_t count = 10000;
+    const unsigned workers = util::worker_count(4, count);
+    std::vector<int> seen(count, 0);
+    std::vector<std::size_t> sums(workers, 0);
+    util::parallel_for(count, 4, [&seen, &sums](std::size_t index, unsigned worker) {
+        ++seen[index];
+        sums[worker] += index;
+    });
+
+    ASSERT_EQ(std::count(seen.begin(), seen.end(), 1), (long) count);
+    ASSERT_EQ(std::accumulate(sums.begin(), sums.end(), std::size_t(0)), count * (count - 1) / 2);
+
+    bool ran = false;
+    util::parallel_for(0, 4, [&ran](std::size_t, unsigned) { ran = true; });
+    ASSERT_FALSE(ran);
+}
+
+TEST(UtilParallel, WorkerPoolReused) {
+    util::WorkerPool pool(4);
+    ASSERT_EQ(pool.size(), util::worker_count(4, 1000));
+    for (std::size_t count : {0, 1, 3, 1000, 5000}) {
+        std::vector<int> seen(count, 0);
+        std::vector<std::size_t> sums(pool.size(), 0);
+        for (int round = 0; round < 20; ++round) {
+            pool.run(count, [&seen, &sums](std::size_t index, unsigned worker) {
+                ++seen[index];
+                sums[worker] += index;
+            });
+        }
+
+        ASSERT_EQ(std::count(seen.begin(), seen.end(), 20), (long) count);
+        ASSERT_EQ(std::accumulate(sums.begin(), sums.end(), std::size_t(0)),
+                count ? 20 * count * (count - 1) / 2 : 0);
+    }
+
+    util::WorkerPool single(1);
+    int ran = 0;
+    single.run(5, [&ran](std::size_t, unsigned worker) { ran += worker == 0; });
+    ASSERT_EQ(ran, 5);
+}
@@ -0,0 +1,131 @@
+/**
+ * Minimal path sums over many matrices at once.
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+
+#include "mapped_file.hpp"
+#include "matrix_file.hpp"
+#include "parallel.hpp"
+#include "path_batch.hpp"
+
+namespace util {
+
+/************** Global Vars & Functions *******************/
+inline void check_moves(unsigned moves) {
+    if (moves != MOVES_TWO && moves != MOVES_THREE && moves != MOVES_FOUR) {
+        throw std::invalid_argument("Paths move two, three or four ways.");
+    }
+}
+
+unsigned movement_model(int ways) {
+    switch (ways) {
+        case 2:
+            return MOVES_TWO;
+        case 3:
+            return MOVES_THREE;
+        case 4:
+            return MOVES_FOUR;
+        default:
+            throw std::invalid_argument("Paths move two, three or four ways.");
+    }
+}
+
+int min_path_sum(const Matrix<int> &matrix, unsigned moves, PathScratch &scratch) {
+    check_moves(moves);
+    check_weights(matrix);
+    if (matrix.empty()) {
+        return 0;
+    }
+
+    if (moves == MOVES_TWO) {
+        return min_sum_two_way(matrix, scratch.sums);
+    } else if (moves == MOVES_THREE) {
+        return min_sum_three_way(matrix, scratch.sums, scratch.columns);
+    }
+
+    dijkstra(matrix, 0, MOVES_FOUR, scratch.sums, scratch.heap);
+    return scratch.sums.back();
+}
+
+std::vector<int> solve_batch(const std::string &path, unsigned moves, unsigned threads, BatchStats *stats) {
+    check_moves(moves);
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::string> names;
+    if (std::filesystem::is_directory(path)) {
+        for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(path)) {
+            if (entry.is_regular_file()) {
+                names.push_back(entry.path().string());
+            }
+        }
+        std::sort(names.begin(), names.end());
+    } else {
+        names.push_back(path);
+    }
+
+    // Every file stays mapped for the whole batch, tasks parse straight from the maps.
+    std::vector<std::unique_ptr<MappedFile>> files;
+    std::vector<std::pair<const char *, std::size_t>> blocks;
+    std::vector<std::size_t> block_files;
+    for (const std::string &name : names) {
+        files.push_back(std::unique_ptr<MappedFile>(new MappedFile(name)));
+        const MappedFile &file = *files.back();
+        file.advise_sequential();
+        for (const std::pair<std::size_t, std::size_t> &block : split_blocks(file.data(), file.size())) {
+            blocks.push_back(std::make_pair(file.data() + block.first, block.second - block.first));
+            block_files.push_back(files.size() - 1);
+        }
+    }
+
+    std::vector<int> sums(blocks.size(), 0);
+    std::vector<std::string> errors(blocks.size());
+    std::vector<PathScratch> scratch(worker_count(threads, blocks.size()));
+    std::vector<std::size_t> cells(scratch.size(), 0);
+    parallel_for(blocks.size(), threads, [&](std::size_t index, unsigned worker) {
+        PathScratch &mine = scratch[worker];
+        try {
+            Matrix<int> matrix = parse_matrix(blocks[index].first, blocks[index].second, std::move(mine.cells));
+            sums[index] = min_path_sum(matrix, moves, mine);
+            cells[worker] += matrix.size();
+            mine.cells = matrix.release();
+        } catch (const std::exception &error) {
+            errors[index] = error.what();
+        }
+    });
+
+    for (std::size_t index = 0; index < blocks.size(); ++index) {
+        if (!errors[index].empty()) {
+            std::size_t first = index;
+            while (first > 0 && block_files[first - 1] == block_files[index]) {
+                --first;
+            }
+            throw std::runtime_error("Matrix " + std::to_string(index - first) + " of "
+                    + names[block_files[index]] + ": " + errors[index]);
+        }
+    }
+
+    if (stats != NULL) {
+        stats->matrices = blocks.size();
+        stats->cells = std::accumulate(cells.begin(), cells.end(), std::size_t(0));
+        stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    return sums;
+}
+
+void write_sums(std::ostream &os, const std::vector<int> &sums) {
+    for (int sum : sums) {
+        os << sum << '\n';
+    }
+}
+
+} /* end util:: */
@@ -0,0 +1,67 @@
+#ifndef _PATH_BATCH_HPP_
+#define _PATH_BATCH_HPP_
+
+/********************* Header Files ***********************/
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "grid_path.hpp"
+#include "matrix.hpp"
+#include "radix_heap.hpp"
+
+namespace util {
+
+/************** Class & Func Declarations *****************/
+/*
+ * Buffers min_path_sum & solve_batch work in, one per worker & kept between
+ * matrices so a batch only allocates while its largest matrix grows them.
+ */
+class PathScratch {
+public:
+    std::vector<int> cells;
+    std::vector<int> sums;
+    // matrix transposed by the three way model.
+    Matrix<int> columns;
+    RadixHeap<std::uint32_t> heap;
+};
+
+class BatchStats {
+public:
+    std::size_t matrices = 0;
+    std::size_t cells = 0;
+    // Wall time from listing the input to the last sum.
+    double seconds = 0.0;
+
+    double per_second() const { return seconds > 0.0 ? matrices / seconds : 0.0; }
+};
+
+/* Move mask for the 2, 3 or 4 way model, throws std::invalid_argument on any other ways. */
+unsigned movement_model(int ways);
+
+/*
+ * Minimal path sum of matrix under the movement model of problem 81, 82 or 83:
+ *  MOVES_TWO, top left to bottom right moving right & down.
+ *  MOVES_THREE, any left cell to any right cell moving up, right & down.
+ *  MOVES_FOUR, top left to bottom right moving any way.
+ * 0 for an empty matrix. Throws std::invalid_argument on other moves or negative cells.
+ */
+int min_path_sum(const Matrix<int> &matrix, unsigned moves, PathScratch &scratch);
+
+/*
+ * min_path_sum of every matrix under path, in order. path is a file of matrices
+ * separated by blank lines or a directory whose regular files are read that way
+ * in name order. Matrices are parsed & solved on threads workers (0 for all cores).
+ * Throws std::runtime_error naming the first matrix that can't be read or solved.
+ */
+std::vector<int> solve_batch(const std::string &path, unsigned moves, unsigned threads = 0,
+        BatchStats *stats = NULL);
+
+/* One sum per line, the compact form of a batch's results. */
+void write_sums(std::ostream &os, const std::vector<int> &sums);
+
+} /* end util:: */
+
+#endif /* _PATH_BATCH_HPP_ */
@@ -0,0 +1,124 @@
+/**
+ * Test cases for the batch path sum solver
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "path_batch.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+
+/************** Global Vars & Functions *******************/
+static const std::string BATCH_FNAME = "/tmp/util_path_batch_test.txt";
+static const std::string BATCH_DIR = "/tmp/util_path_batch_test";
+static const std::string EXAMPLE =
+    "131,673,234,103,18\n"
+    "201,96,342,965,150\n"
+    "630,803,746,422,111\n"
+    "537,699,497,121,956\n"
+    "805,732,524,37,331\n";
+
+util::Matrix<int> example() {
+    util::Matrix<int> matrix(5, 5, std::vector<int>({
+        131, 673, 234, 103, 18,
+        201, 96, 342, 965, 150,
+        630, 803, 746, 422, 111,
+        537, 699, 497, 121, 956,
+        805, 732, 524, 37, 331,
+    }));
+
+    return matrix;
+}
+
+void write_file(const std::string &name, const std::string &text) {
+    std::ofstream fout(name);
+    fout << text;
+}
+
+TEST(UtilPathBatch, MinPathSum) {
+    util::PathScratch scratch;
+    ASSERT_EQ(util::min_path_sum(example(), util::movement_model(2), scratch), 2427);
+    ASSERT_EQ(util::min_path_sum(example(), util::movement_model(3), scratch), 994);
+    ASSERT_EQ(util::min_path_sum(example(), util::movement_model(4), scratch), 2297);
+    ASSERT_EQ(util::min_path_sum(util::Matrix<int>(), util::MOVES_FOUR, scratch), 0);
+    ASSERT_EQ(util::min_path_sum(util::Matrix<int>(3, 1, 2), util::MOVES_THREE, scratch), 2);
+    ASSERT_THROW(util::movement_model(5), std::invalid_argument);
+    ASSERT_THROW(util::min_path_sum(example(), util::MOVE_UP, scratch), std::invalid_argument);
+}
+
+TEST(UtilPathBatch, MatchesDijkstra) {
+    std::mt19937 gen(50);
+    std::uniform_int_distribution<int> dist(0, 9999);
+    util::PathScratch scratch;
+    for (int round = 0; round < 20; ++round) {
+        util::Matrix<int> matrix(1 + gen() % 30, 1 + gen() % 30);
+        for (std::size_t index = 0; index < matrix.size(); ++index) {
+            matrix[index] = dist(gen);
+        }
+
+        ASSERT_EQ(util::min_path_sum(matrix, util::MOVES_TWO, scratch),
+                util::dijkstra(matrix, 0, util::MOVES_TWO).back());
+        ASSERT_EQ(util::min_path_sum(matrix, util::MOVES_FOUR, scratch), util::dijkstra(matrix).back());
+        int best = util::NO_PATH;
+        for (std::size_t row = 0; row < matrix.rows(); ++row) {
+            std::vector<int> sums = util::dijkstra(matrix, matrix.index(row, 0), util::MOVES_THREE);
+            for (std::size_t end = 0; end < matrix.rows(); ++end) {
+                best = std::min(best, sums[matrix.index(end, matrix.cols() - 1)]);
+            }
+        }
+        ASSERT_EQ(util::min_path_sum(matrix, util::MOVES_THREE, scratch), best);
+    }
+}
+
+TEST(UtilPathBatch, SolveFile) {
+    std::string spaced = EXAMPLE;
+    std::replace(spaced.begin(), spaced.end(), ',', ' ');
+    write_file(BATCH_FNAME, "\n" + EXAMPLE + "\r\n\n" + spaced + "\n1,2\n3,4\n");
+
+    util::BatchStats stats;
+    std::vector<int> sums = util::solve_batch(BATCH_FNAME, util::MOVES_TWO, 2, &stats);
+    ASSERT_EQ(sums, std::vector<int>({2427, 2427, 7}));
+    ASSERT_EQ(stats.matrices, 3);
+    ASSERT_EQ(stats.cells, 54);
+    ASSERT_EQ(util::solve_batch(BATCH_FNAME, util::MOVES_THREE), std::vector<int>({994, 994, 3}));
+
+    std::stringstream ss;
+    util::write_sums(ss, sums);
+    ASSERT_EQ(ss.str(), "2427\n2427\n7\n");
+
+    write_file(BATCH_FNAME, EXAMPLE + "\n1,2\n3\n");
+    try {
+        util::solve_batch(BATCH_FNAME, util::MOVES_FOUR);
+        FAIL() << "Ragged matrix was solved";
+    } catch (const std::runtime_error &error) {
+        ASSERT_NE(std::string(error.what()).find("Matrix 1 of " + BATCH_FNAME), std::string::npos);
+    }
+    ASSERT_THROW(util::solve_batch(BATCH_FNAME, util::MOVE_LEFT), std::invalid_argument);
+
+    std::remove(BATCH_FNAME.c_str());
+    ASSERT_THROW(util::solve_batch(BATCH_FNAME, util::MOVES_FOUR), std::runtime_error);
+}
+
+TEST(UtilPathBatch, SolveDirectory) {
+    std::filesystem::remove_all(BATCH_DIR);
+    std::filesystem::create_directory(BATCH_DIR);
+    write_file(BATCH_DIR + "/b.txt", "1 2\n3 4\n\n5\n");
+    write_file(BATCH_DIR + "/a.txt", EXAMPLE);
+    std::filesystem::create_directory(BATCH_DIR + "/skipped");
+
+    ASSERT_EQ(util::solve_batch(BATCH_DIR, util::MOVES_FOUR), std::vector<int>({2297, 7, 5}));
+    std::filesystem::remove_all(BATCH_DIR);
+}
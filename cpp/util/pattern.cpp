@@ -0,0 +1,265 @@
+/**
+ * Word patterns (isomorphism classes) and an index to search words by them.
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <algorithm>
+
+#include "pattern.hpp"
+
+namespace util {
+
+/***************** Constants & Macros *********************/
+// Decimal digits in the largest 64 bit number.
+static const int MAX_DIGITS = 20;
+
+/************** Global Vars & Functions *******************/
+pattern_t pattern_word(const char *word, std::size_t length) {
+    if (length > PATTERN_LENGTH) {
+        return NO_PATTERN;
+    }
+
+    // Symbol given to each char seen, 0 if not seen yet.
+    std::uint8_t symbols[256] = {0};
+    pattern_t code = 0;
+    pattern_t next = 1;
+    for (std::size_t i = 0; i < length; ++i) {
+        std::uint8_t &symbol = symbols[static_cast<unsigned char>(word[i])];
+        if (symbol == 0) {
+            if (next > PATTERN_SYMBOLS) {
+                return NO_PATTERN;
+            }
+            symbol = next++;
+        }
+        code |= static_cast<pattern_t>(symbol) << (i * PATTERN_BITS);
+    }
+
+    return code;
+}
+
+pattern_t pattern_number(std::uint64_t num) {
+    char digits[MAX_DIGITS];
+    int length = 0;
+    do {
+        digits[length++] = '0' + num % 10;
+        num /= 10;
+    } while (num != 0);
+    std::reverse(digits, digits + length);
+
+    return pattern_word(digits, length);
+}
+
+std::string pattern_text(pattern_t code) {
+    std::string text;
+    while (code != 0) {
+        text += 'A' + (code & PATTERN_MASK) - 1;
+        code >>= PATTERN_BITS;
+    }
+
+    return text;
+}
+
+bool Substitution::assign(char cipher, char plain) {
+    char &mapped = forward[static_cast<unsigned char>(cipher)];
+    if (cipher == 0 || plain == 0) {
+        return false;
+    } else if (mapped != 0) {
+        return mapped == plain;
+    } else if (used(plain)) {
+        return false;
+    }
+
+    mapped = plain;
+    backward[static_cast<unsigned char>(plain)] = cipher;
+    ++assigned;
+    return true;
+}
+
+bool Substitution::assign_word(const std::string &cipher, const std::string &plain) {
+    if (cipher.size() != plain.size()) {
+        return false;
+    }
+
+    // Work on a copy so a conflict part way leaves this untouched.
+    Substitution next = *this;
+    for (std::size_t i = 0; i < cipher.size(); ++i) {
+        if (!next.assign(cipher[i], plain[i])) {
+            return false;
+        }
+    }
+    *this = next;
+
+    return true;
+}
+
+void Substitution::unassign(char cipher) {
+    char &mapped = forward[static_cast<unsigned char>(cipher)];
+    if (mapped != 0) {
+        backward[static_cast<unsigned char>(mapped)] = 0;
+        mapped = 0;
+        --assigned;
+    }
+}
+
+inline std::uint64_t posting_key(std::size_t group, std::size_t pos, char letter) {
+    return static_cast<std::uint64_t>(group) << 12 | pos << 8 | static_cast<unsigned char>(letter);
+}
+
+PatternIndex::PatternIndex(const std::vector<std::string> &input) {
+    std::vector<std::pair<pattern_t, const std::string *> > keyed;
+    for (const std::string &word : input) {
+        pattern_t pattern = pattern_word(word);
+        if (pattern != NO_PATTERN) {
+            keyed.push_back(std::make_pair(pattern, &word));
+        }
+    }
+    std::sort(keyed.begin(), keyed.end(),
+            [](const std::pair<pattern_t, const std::string *> &left,
+                const std::pair<pattern_t, const std::string *> &right) {
+        return left.first < right.first || (left.first == right.first && *left.second < *right.second);
+    });
+
+    words.reserve(keyed.size());
+    for (std::size_t i = 0; i < keyed.size(); ++i) {
+        if (i != 0 && keyed[i].first == keyed[i - 1].first && *keyed[i].second == *keyed[i - 1].second) {
+            continue;
+        }
+        if (groups.empty() || groups.back().pattern != keyed[i].first) {
+            groups.push_back(Group {keyed[i].first, words.size(), 0});
+        }
+        words.push_back(*keyed[i].second);
+        ++groups.back().count;
+    }
+
+    // Bitsets only where a symbol first appears, later uses must repeat that char.
+    for (std::size_t group = 0; group < groups.size(); ++group) {
+        const Group &entry = groups[group];
+        const std::size_t blocks = (entry.count + 63) / 64;
+        pattern_t seen = 0;
+        for (std::size_t pos = 0; pos < PATTERN_LENGTH; ++pos) {
+            pattern_t symbol = (entry.pattern >> (pos * PATTERN_BITS)) & PATTERN_MASK;
+            if (symbol == 0) {
+                break;
+            } else if (seen & (1ULL << symbol)) {
+                continue;
+            }
+            seen |= 1ULL << symbol;
+
+            for (std::size_t word = 0; word < entry.count; ++word) {
+                std::uint64_t key = posting_key(group, pos, words[entry.first + word][pos]);
+                auto found = postings.find(key);
+                std::size_t offset;
+                if (found == postings.end()) {
+                    offset = bits.size();
+                    postings[key] = offset;
+                    bits.resize(bits.size() + blocks, 0);
+                } else {
+                    offset = found->second;
+                }
+                bits[offset + word / 64] |= 1ULL << (word % 64);
+            }
+        }
+    }
+}
+
+PatternIndex PatternIndex::from_numbers(const std::vector<std::uint64_t> &numbers) {
+    std::vector<std::string> words;
+    words.reserve(numbers.size());
+    for (std::uint64_t num : numbers) {
+        words.push_back(std::to_string(num));
+    }
+
+    return PatternIndex(words);
+}
+
+/* Index of the group with pattern, groups.size() if none. */
+std::size_t PatternIndex::find_group(pattern_t pattern) const {
+    auto found = std::lower_bound(groups.begin(), groups.end(), pattern,
+            [](const Group &group, pattern_t pattern) { return group.pattern < pattern; });
+    if (found == groups.end() || found->pattern != pattern) {
+        return groups.size();
+    }
+
+    return found - groups.begin();
+}
+
+/* Bitset of group's words with letter at pos, NULL if none. */
+const std::uint64_t * PatternIndex::posting(std::size_t group, std::size_t pos, char letter) const {
+    auto found = postings.find(posting_key(group, pos, letter));
+    return found == postings.end() ? NULL : bits.data() + found->second;
+}
+
+CandidateRange PatternIndex::candidates(pattern_t pattern) const {
+    std::size_t group = find_group(pattern);
+    if (group == groups.size()) {
+        return CandidateRange();
+    }
+
+    const std::string *first = words.data() + groups[group].first;
+    return CandidateRange(first, first + groups[group].count);
+}
+
+std::vector<std::string> PatternIndex::match(const std::string &cipher, const Substitution &sub) const {
+    std::vector<std::string> result;
+    const pattern_t pattern = pattern_word(cipher);
+    const std::size_t group = pattern == NO_PATTERN ? groups.size() : find_group(pattern);
+    if (group == groups.size()) {
+        return result;
+    }
+
+    const Group &entry = groups[group];
+    const std::size_t blocks = (entry.count + 63) / 64;
+    std::vector<std::uint64_t> alive(blocks, ~0ULL);
+    if (entry.count % 64) {
+        alive.back() = (1ULL << (entry.count % 64)) - 1;
+    }
+
+    // Plain chars already taken, an unassigned cipher char may use none of them.
+    std::vector<char> taken;
+    for (int plain = 1; plain < 256; ++plain) {
+        if (sub.used(static_cast<char>(plain))) {
+            taken.push_back(static_cast<char>(plain));
+        }
+    }
+
+    pattern_t seen = 0;
+    for (std::size_t pos = 0; pos < cipher.size(); ++pos) {
+        pattern_t symbol = (pattern >> (pos * PATTERN_BITS)) & PATTERN_MASK;
+        if (seen & (1ULL << symbol)) {
+            continue;
+        }
+        seen |= 1ULL << symbol;
+
+        const char plain = sub.plain(cipher[pos]);
+        if (plain != 0) {
+            const std::uint64_t *set = posting(group, pos, plain);
+            if (set == NULL) {
+                return result;
+            }
+            for (std::size_t block = 0; block < blocks; ++block) {
+                alive[block] &= set[block];
+            }
+        } else {
+            for (char used : taken) {
+                const std::uint64_t *set = posting(group, pos, used);
+                if (set != NULL) {
+                    for (std::size_t block = 0; block < blocks; ++block) {
+                        alive[block] &= ~set[block];
+                    }
+                }
+            }
+        }
+    }
+
+    for (std::size_t block = 0; block < blocks; ++block) {
+        std::uint64_t live = alive[block];
+        while (live) {
+            result.push_back(words[entry.first + block * 64 + __builtin_ctzll(live)]);
+            live &= live - 1;
+        }
+    }
+
+    return result;
+}
+
+} /* end util:: */
@@ -0,0 +1,138 @@
+#ifndef _PATTERN_HPP_
+#define _PATTERN_HPP_
+
+/********************* Header Files ***********************/
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flat_map.hpp"
+
+namespace util {
+
+/******************* Constants/Macros *********************/
+// Packed word pattern, see pattern_word.
+typedef std::uint64_t pattern_t;
+static const int PATTERN_BITS = 4;
+static const pattern_t PATTERN_MASK = (1 << PATTERN_BITS) - 1;
+static const std::size_t PATTERN_LENGTH = 64 / PATTERN_BITS;
+static const pattern_t PATTERN_SYMBOLS = PATTERN_MASK;
+static const pattern_t NO_PATTERN = 0;
+
+/************** Class & Func Declarations *****************/
+/*
+ * Isomorphism class of a string packed as a code, 4 bits per position with
+ * position 0 lowest. Each position holds 1 + the number of distinct chars seen
+ * before that char's first use, so the code ends at the first 0 nibble.
+ * i.e. 1952 => ABCD, 1992 & 1223 => ABBC, WILLING => ABCCBDE (see pattern_text).
+ * Words over PATTERN_LENGTH chars or PATTERN_SYMBOLS distinct ones get NO_PATTERN.
+ */
+pattern_t pattern_word(const char *word, std::size_t length);
+inline pattern_t pattern_word(const std::string &word) {
+    return pattern_word(word.data(), word.size());
+}
+/* Same as pattern_word(std::to_string(num)). */
+pattern_t pattern_number(std::uint64_t num);
+/* Readable form of a code, i.e. ABCCBDE for the code of WILLING. */
+std::string pattern_text(pattern_t code);
+/* Chars in the words with this code. */
+inline std::size_t pattern_length(pattern_t code) {
+    return code == NO_PATTERN ? 0 : (64 - __builtin_clzll(code) + PATTERN_BITS - 1) / PATTERN_BITS;
+}
+/* Distinct chars in the words with this code, which is also its highest symbol. */
+inline pattern_t pattern_symbols(pattern_t code) {
+    pattern_t highest = 0;
+    for (; code != 0; code >>= PATTERN_BITS) {
+        highest = std::max(highest, code & PATTERN_MASK);
+    }
+    return highest;
+}
+
+/*
+ * Partial one to one substitution of cipher chars by plain chars.
+ * The NUL char can't be mapped, it marks unassigned.
+ */
+class Substitution {
+public:
+    /* Map cipher to plain, false if either is already mapped elsewhere. */
+    bool assign(char cipher, char plain);
+    /* Assign each char of cipher to the plain char at the same place, false on a conflict. */
+    bool assign_word(const std::string &cipher, const std::string &plain);
+    void unassign(char cipher);
+    /* Plain char for cipher, NUL if unassigned. */
+    char plain(char cipher) const {
+        return forward[static_cast<unsigned char>(cipher)];
+    }
+    bool used(char plain) const {
+        return backward[static_cast<unsigned char>(plain)] != 0;
+    }
+    std::size_t size() const { return assigned; }
+
+private:
+    char forward[256] = {0};
+    char backward[256] = {0};
+    std::size_t assigned = 0;
+};
+
+/* Words sharing one pattern, contiguous within a PatternIndex. */
+class CandidateRange {
+public:
+    CandidateRange(const std::string *first = NULL, const std::string *last = NULL) :
+            first(first), last(last) {};
+    const std::string * begin() const { return first; }
+    const std::string * end() const { return last; }
+    std::size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+
+private:
+    const std::string *first;
+    const std::string *last;
+};
+
+/*
+ * Words grouped by pattern for cryptogram style searches.
+ * Each group's words are sorted & contiguous, groups are sorted by pattern.
+ * For each group, position where a symbol first appears & char there is a
+ * bitset of the words with that char, so a query only ANDs bitsets.
+ */
+class PatternIndex {
+public:
+    /* Words without a pattern are skipped, exact repeats are kept once. */
+    explicit PatternIndex(const std::vector<std::string> &words);
+    /* Index the decimal form of each number. */
+    static PatternIndex from_numbers(const std::vector<std::uint64_t> &numbers);
+
+    CandidateRange candidates(pattern_t pattern) const;
+    /*
+     * Words with the pattern of cipher that agree with every assigned char of
+     * cipher & put no plain char sub already uses under an unassigned one.
+     * Any of them extends sub one to one by assign_word(cipher, word).
+     */
+    std::vector<std::string> match(const std::string &cipher, const Substitution &sub) const;
+
+    std::size_t num_patterns() const { return groups.size(); }
+    std::size_t size() const { return words.size(); }
+
+private:
+    class Group {
+    public:
+        pattern_t pattern;
+        // Index of the first word & count.
+        std::size_t first;
+        std::size_t count;
+    };
+
+    std::size_t find_group(pattern_t pattern) const;
+    const std::uint64_t * posting(std::size_t group, std::size_t pos, char letter) const;
+
+    std::vector<std::string> words;
+    std::vector<Group> groups;
+    // (group, position, char) => offset of the bitset in bits.
+    FlatMap<std::uint64_t, std::size_t> postings;
+    std::vector<std::uint64_t> bits;
+};
+
+} /* end util:: */
+
+#endif /* _PATTERN_HPP_ */
@@ -0,0 +1,117 @@
+/**
+ * Test cases for word patterns and the pattern index
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <algorithm>
+
+#include "gtest/gtest.h"
+#include "pattern.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+
+/************** Global Vars & Functions *******************/
+static const std::vector<std::string> PATTERN_WORDS = {
+    "HELLO", "WORLD", "SHEEP", "ALLEY", "APPLE", "HILLS", "BALLS", "CELLO", "HELLO", "TREE", "WILLING"
+};
+
+TEST(UtilPattern, PatternWord) {
+    ASSERT_EQ(util::pattern_word(std::string("1952")), 0x4321);
+    ASSERT_EQ(util::pattern_text(util::pattern_word(std::string("WILLING"))), "ABCCBDE");
+    ASSERT_EQ(util::pattern_word(std::string("1223")), util::pattern_word(std::string("1992")));
+    ASSERT_EQ(util::pattern_word(std::string("ABCDEFGHIJKLMNOP")), util::NO_PATTERN);
+    ASSERT_EQ(util::pattern_number(1000000007), util::pattern_word(std::string("1000000007")));
+    ASSERT_EQ(util::pattern_length(util::pattern_word(std::string("WILLING"))), 7);
+    ASSERT_EQ(util::pattern_symbols(util::pattern_word(std::string("WILLING"))), 5);
+    ASSERT_EQ(util::pattern_length(util::NO_PATTERN), 0);
+}
+
+TEST(UtilPattern, Substitution) {
+    util::Substitution sub;
+    ASSERT_TRUE(sub.assign('X', 'A'));
+    ASSERT_TRUE(sub.assign('X', 'A'));
+    ASSERT_FALSE(sub.assign('X', 'B'));
+    ASSERT_FALSE(sub.assign('Y', 'A'));
+    ASSERT_EQ(sub.plain('X'), 'A');
+    ASSERT_TRUE(sub.used('A'));
+
+    ASSERT_FALSE(sub.assign_word("XYZ", "ABA"));
+    ASSERT_EQ(sub.size(), 1);
+    ASSERT_EQ(sub.plain('Y'), 0);
+    ASSERT_TRUE(sub.assign_word("XYZ", "ABC"));
+    ASSERT_EQ(sub.size(), 3);
+
+    sub.unassign('X');
+    ASSERT_FALSE(sub.used('A'));
+    ASSERT_TRUE(sub.assign('Q', 'A'));
+}
+
+TEST(UtilPattern, Candidates) {
+    util::PatternIndex index(PATTERN_WORDS);
+    ASSERT_EQ(index.size(), 10);
+
+    auto range = index.candidates(util::pattern_word(std::string("XYZZW")));
+    std::vector<std::string> expect = {"BALLS", "CELLO", "HELLO", "HILLS", "SHEEP"};
+    ASSERT_EQ(std::vector<std::string>(range.begin(), range.end()), expect);
+    ASSERT_TRUE(index.candidates(util::pattern_word(std::string("XYZZYX"))).empty());
+}
+
+TEST(UtilPattern, MatchPartialAssignment) {
+    util::PatternIndex index(PATTERN_WORDS);
+    util::Substitution sub;
+    ASSERT_EQ(index.match("QRSST", sub).size(), 5);
+    ASSERT_TRUE(index.match("QRSSR", sub).empty());
+
+    // Second letter fixed to E leaves words with E there.
+    ASSERT_TRUE(sub.assign('R', 'E'));
+    ASSERT_EQ(index.match("QRSST", sub), std::vector<std::string>({"CELLO", "HELLO"}));
+
+    // H taken by another cipher letter rules out HELLO.
+    ASSERT_TRUE(sub.assign('Z', 'H'));
+    ASSERT_EQ(index.match("QRSST", sub), std::vector<std::string>({"CELLO"}));
+    ASSERT_TRUE(index.match("ABC", sub).empty());
+}
+
+TEST(UtilPattern, MatchNumbers) {
+    util::PatternIndex squares = util::PatternIndex::from_numbers({1024, 1089, 1296, 9216, 4096, 1225});
+    util::Substitution sub;
+    ASSERT_TRUE(sub.assign_word("CARE", "1296"));
+    std::vector<std::string> found = squares.match("RACE", sub);
+    ASSERT_EQ(found, std::vector<std::string>({"9216"}));
+
+    // Against brute force over every candidate.
+    util::Substitution part;
+    ASSERT_TRUE(part.assign('P', '1'));
+    std::vector<std::string> brute;
+    for (const std::string &word : squares.candidates(util::pattern_word(std::string("POST")))) {
+        util::Substitution copy = part;
+        if (copy.assign_word("POST", word)) {
+            brute.push_back(word);
+        }
+    }
+    ASSERT_EQ(squares.match("POST", part), brute);
+}
+
+TEST(UtilPattern, LargeGroup) {
+    // Over 64 words in one group spans several bitset blocks.
+    std::vector<std::string> words;
+    for (char first = 'A'; first <= 'Z'; ++first) {
+        for (char second = 'A'; second <= 'Z'; ++second) {
+            if (first != second) {
+                words.push_back(std::string(1, first) + second);
+            }
+        }
+    }
+    util::PatternIndex index(words);
+    util::Substitution sub;
+    ASSERT_EQ(index.match("XY", sub).size(), 650);
+    ASSERT_TRUE(sub.assign('Y', 'Q'));
+    ASSERT_TRUE(sub.assign('W', 'Z'));
+    std::vector<std::string> found = index.match("XY", sub);
+    ASSERT_EQ(found.size(), 24);
+    ASSERT_TRUE(std::all_of(found.begin(), found.end(),
+                [](const std::string &word) { return word[1] == 'Q' && word[0] != 'Z'; }));
+}
@@ -0,0 +1,445 @@
+/**
+ * Fast poker hand evaluation on packed cards.
+ * Cards are tallied into per suit rank masks, rank counts come from adding
+ * those masks bitwise so no loop over ranks or allocation is done.
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <sstream>
+#include <stdexcept>
+
+/* C Headers */
+#if defined(__x86_64__) || defined(__i386__)
+#define POKER_AVX2
+#include <immintrin.h>
+#endif
+
+#include "poker.hpp"
+
+namespace util {
+
+namespace poker {
+
+/***************** Constants & Macros *********************/
+static const std::string RANK_TEXT = "23456789TJQKA";
+static const std::string SUIT_TEXT = "HDCS";
+// Low 20 bits of a rank_table() entry, the packed top 5 ranks.
+static const std::uint32_t TOP_RANKS = (1u << CATEGORY_SHIFT) - 1;
+static const char *CATEGORY_TEXT[] = {
+    "Unranked",
+    "Highest Card",
+    "One Pair",
+    "Two Pairs",
+    "Three of a kind",
+    "Straight",
+    "Flush",
+    "Full House",
+    "Four of a kind",
+    "Straight Flush",
+    "Royal Flush",
+};
+
+/************** Global Vars & Functions *******************/
+bool parse_card(const char *text, card_t &card) {
+    int rank = -1;
+    switch (text[0]) {
+        case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9':
+            rank = text[0] - '2';
+            break;
+        case 'T':
+            rank = 8;
+            break;
+        case 'J':
+            rank = 9;
+            break;
+        case 'Q':
+            rank = 10;
+            break;
+        case 'K':
+            rank = 11;
+            break;
+        case 'A':
+            rank = 12;
+            break;
+        default:
+            return false;
+    }
+
+    switch (text[1]) {
+        case 'H':
+            card = make_card(rank, Hearts);
+            return true;
+        case 'D':
+            card = make_card(rank, Diamonds);
+            return true;
+        case 'C':
+            card = make_card(rank, Clubs);
+            return true;
+        case 'S':
+            card = make_card(rank, Spades);
+            return true;
+        default:
+            return false;
+    }
+}
+
+card_t parse_card(const std::string &text) {
+    card_t card;
+    if (text.size() != 2) {
+        throw std::invalid_argument("Card text must be two chars: " + text);
+    }
+    if (!parse_card(text.c_str(), card)) {
+        throw std::invalid_argument("Unknown card: " + text);
+    }
+
+    return card;
+}
+
+std::vector<card_t> parse_cards(const std::string &text) {
+    std::vector<card_t> cards;
+    std::stringstream ss(text);
+    std::string word;
+    while (ss >> word) {
+        cards.push_back(parse_card(word));
+    }
+
+    return cards;
+}
+
+std::string card_text(card_t card) {
+    return std::string(1, RANK_TEXT[card_rank(card)]) + SUIT_TEXT[card_suit(card)];
+}
+
+std::string category_text(Category cat) {
+    return CATEGORY_TEXT[cat];
+}
+
+int straight_high(std::uint32_t rank_mask) {
+    // Shift up one so bit 0 can hold the ace playing low.
+    std::uint32_t mask = (rank_mask << 1) | (rank_mask >> (NUM_RANKS - 1));
+    std::uint32_t runs = mask & (mask >> 1) & (mask >> 2) & (mask >> 3) & (mask >> 4);
+    if (runs == 0) {
+        return -1;
+    }
+
+    // Lowest bit of the highest run, its top card is 4 ranks up, less the shift.
+    return 31 - __builtin_clz(runs) + 3;
+}
+
+/* Pack category & up to 5 ranks, first rank is most significant. */
+inline strength_t make_strength(Category cat, const int *ranks, int num) {
+    strength_t strength = cat;
+    for (int i = 0; i < 5; ++i) {
+        strength = (strength << 4) | (i < num ? ranks[i] : 0);
+    }
+
+    return strength;
+}
+
+inline int highest_rank(std::uint32_t mask) {
+    return 31 - __builtin_clz(mask);
+}
+
+/* Write the num highest ranks of mask into ranks, returns ranks written. */
+inline int top_ranks(std::uint32_t mask, int num, int *ranks) {
+    int found = 0;
+    while (mask && found < num) {
+        ranks[found] = highest_rank(mask);
+        mask &= ~(1u << ranks[found++]);
+    }
+
+    return found;
+}
+
+strength_t evaluate(const card_t *cards, int count) {
+    std::uint32_t suit_masks[NUM_SUITS] = {0, 0, 0, 0};
+    for (int i = 0; i < count; ++i) {
+        suit_masks[card_suit(cards[i])] |= 1u << card_rank(cards[i]);
+    }
+    const std::uint32_t s0 = suit_masks[0], s1 = suit_masks[1];
+    const std::uint32_t s2 = suit_masks[2], s3 = suit_masks[3];
+    const std::uint32_t all_ranks = s0 | s1 | s2 | s3;
+
+    // With at most 7 cards only one suit can hold 5.
+    std::uint32_t flush_mask = 0;
+    for (std::uint32_t mask : suit_masks) {
+        if (__builtin_popcount(mask) >= 5) {
+            flush_mask = mask;
+        }
+    }
+
+    int ranks[5];
+    if (flush_mask) {
+        ranks[0] = straight_high(flush_mask);
+        if (ranks[0] != -1) {
+            Category cat = ranks[0] == NUM_RANKS - 1 ? RoyalFlush : StraightFlush;
+            return make_strength(cat, ranks, 1);
+        }
+    }
+
+    // Add the four suit masks bitwise, each rank's count lands in (fours, twos, ones).
+    const std::uint32_t half_a = s0 ^ s1;
+    const std::uint32_t half_c = s2 ^ s3;
+    const std::uint32_t ones = half_a ^ half_c;
+    const std::uint32_t twos = (s0 & s1) ^ (s2 & s3) ^ (half_a & half_c);
+    const std::uint32_t quads = s0 & s1 & s2 & s3;
+    const std::uint32_t trips = ones & twos;
+    const std::uint32_t pairs = twos & ~ones;
+    const std::uint32_t singles = ones & ~twos;
+
+    if (quads) {
+        ranks[0] = highest_rank(quads);
+        ranks[1] = highest_rank(all_ranks & ~quads);
+        return make_strength(FourKind, ranks, 2);
+    }
+
+    if (trips && (pairs || (trips & (trips - 1)))) {
+        ranks[0] = highest_rank(trips);
+        ranks[1] = highest_rank((trips & ~(1u << ranks[0])) | pairs);
+        return make_strength(FullHouse, ranks, 2);
+    }
+
+    if (flush_mask) {
+        top_ranks(flush_mask, 5, ranks);
+        return make_strength(Flush, ranks, 5);
+    }
+
+    ranks[0] = straight_high(all_ranks);
+    if (ranks[0] != -1) {
+        return make_strength(Straight, ranks, 1);
+    }
+
+    if (trips) {
+        ranks[0] = highest_rank(trips);
+        top_ranks(singles, 2, ranks + 1);
+        return make_strength(ThreeKind, ranks, 3);
+    }
+
+    if (pairs & (pairs - 1)) {
+        top_ranks(pairs, 2, ranks);
+        // A third pair can outrank the best single as kicker.
+        std::uint32_t rest = (pairs & ~(1u << ranks[0]) & ~(1u << ranks[1])) | singles;
+        ranks[2] = highest_rank(rest);
+        return make_strength(TwoPair, ranks, 3);
+    }
+
+    if (pairs) {
+        ranks[0] = highest_rank(pairs);
+        top_ranks(singles, 3, ranks + 1);
+        return make_strength(OnePair, ranks, 4);
+    }
+
+    return make_strength(HighCard, ranks, top_ranks(singles, 5, ranks));
+}
+
+/*
+ * One entry per 13 bit rank mask: the top 5 ranks packed like a strength's
+ * nibbles, plus straight_high + 1 at CATEGORY_SHIFT. One gather gets both.
+ */
+const std::int32_t *rank_table() {
+    static const std::vector<std::int32_t> table = [] {
+        std::vector<std::int32_t> built(1 << NUM_RANKS);
+        for (std::uint32_t mask = 0; mask < built.size(); ++mask) {
+            int ranks[5];
+            int num = top_ranks(mask, 5, ranks);
+            built[mask] = make_strength(Unranked, ranks, num) |
+                (straight_high(mask) + 1) << CATEGORY_SHIFT;
+        }
+        return built;
+    }();
+
+    return table.data();
+}
+
+#ifdef POKER_AVX2
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 inline __m256i gather_ranks(const std::int32_t *table, __m256i mask) {
+    return _mm256_i32gather_epi32(table, mask, 4);
+}
+
+/* Highest rank of a gathered entry's mask. */
+AVX2 inline __m256i entry_high(__m256i entry) {
+    return _mm256_and_si256(_mm256_srli_epi32(entry, 16), _mm256_set1_epi32(0xF));
+}
+
+AVX2 inline __m256i nonzero(__m256i value) {
+    __m256i zero = _mm256_cmpeq_epi32(value, _mm256_setzero_si256());
+    return _mm256_xor_si256(zero, _mm256_set1_epi32(-1));
+}
+
+/* Lanes where cond is set take yes, the rest keep no. */
+AVX2 inline __m256i select(__m256i cond, __m256i yes, __m256i no) {
+    return _mm256_blendv_epi8(no, yes, cond);
+}
+
+AVX2 inline __m256i popcount(__m256i x) {
+    x = _mm256_sub_epi32(x, _mm256_and_si256(_mm256_srli_epi32(x, 1), _mm256_set1_epi32(0x55555555)));
+    x = _mm256_add_epi32(_mm256_and_si256(x, _mm256_set1_epi32(0x33333333)),
+            _mm256_and_si256(_mm256_srli_epi32(x, 2), _mm256_set1_epi32(0x33333333)));
+    x = _mm256_and_si256(_mm256_add_epi32(x, _mm256_srli_epi32(x, 4)), _mm256_set1_epi32(0x0F0F0F0F));
+    return _mm256_srli_epi32(_mm256_mullo_epi32(x, _mm256_set1_epi32(0x01010101)), 24);
+}
+
+AVX2 inline __m256i with_category(Category cat, __m256i ranks) {
+    return _mm256_or_si256(_mm256_set1_epi32(cat << CATEGORY_SHIFT), ranks);
+}
+
+/*
+ * Same steps as evaluate for BATCH_SIZE hands, one per 32 bit lane. Every
+ * category's strength is built for every lane, then blended in rising order
+ * so the best category that applies is left standing.
+ */
+AVX2 void evaluate_avx2(const card_t *cards, int count, std::size_t num_hands,
+        strength_t *strengths) {
+    const std::int32_t *table = rank_table();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i top_ranks = _mm256_set1_epi32(TOP_RANKS);
+
+    __m256i suits[NUM_SUITS];
+    for (__m256i &suit : suits) {
+        suit = _mm256_setzero_si256();
+    }
+    for (int j = 0; j < count; ++j) {
+        __m128i raw = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(cards + j * num_hands));
+        __m256i card = _mm256_cvtepu8_epi32(raw);
+        __m256i bit = _mm256_sllv_epi32(one, _mm256_srli_epi32(card, 2));
+        __m256i suit = _mm256_and_si256(card, _mm256_set1_epi32(3));
+        for (int s = 0; s < NUM_SUITS; ++s) {
+            __m256i match = _mm256_cmpeq_epi32(suit, _mm256_set1_epi32(s));
+            suits[s] = _mm256_or_si256(suits[s], _mm256_and_si256(bit, match));
+        }
+    }
+    const __m256i s0 = suits[0], s1 = suits[1], s2 = suits[2], s3 = suits[3];
+    const __m256i all = _mm256_or_si256(_mm256_or_si256(s0, s1), _mm256_or_si256(s2, s3));
+
+    __m256i flush = _mm256_setzero_si256();
+    for (__m256i suit : suits) {
+        __m256i five = _mm256_cmpgt_epi32(popcount(suit), _mm256_set1_epi32(4));
+        flush = _mm256_or_si256(flush, _mm256_and_si256(suit, five));
+    }
+
+    const __m256i half_a = _mm256_xor_si256(s0, s1);
+    const __m256i half_c = _mm256_xor_si256(s2, s3);
+    const __m256i ones = _mm256_xor_si256(half_a, half_c);
+    const __m256i twos = _mm256_xor_si256(_mm256_xor_si256(_mm256_and_si256(s0, s1),
+                _mm256_and_si256(s2, s3)), _mm256_and_si256(half_a, half_c));
+    const __m256i quads = _mm256_and_si256(_mm256_and_si256(s0, s1), _mm256_and_si256(s2, s3));
+    const __m256i trips = _mm256_and_si256(ones, twos);
+    const __m256i pairs = _mm256_andnot_si256(ones, twos);
+    const __m256i singles = _mm256_andnot_si256(twos, ones);
+
+    const __m256i t_all = gather_ranks(table, all);
+    const __m256i t_flush = gather_ranks(table, flush);
+    const __m256i t_quads = gather_ranks(table, quads);
+    const __m256i t_trips = gather_ranks(table, trips);
+    const __m256i t_pairs = gather_ranks(table, pairs);
+    const __m256i t_singles = gather_ranks(table, singles);
+
+    __m256i result = with_category(HighCard, _mm256_and_si256(t_singles, top_ranks));
+
+    __m256i ranks = _mm256_or_si256(_mm256_slli_epi32(entry_high(t_pairs), 16),
+            _mm256_and_si256(_mm256_srli_epi32(t_singles, 4), _mm256_set1_epi32(0xFFF0)));
+    result = select(nonzero(pairs), with_category(OnePair, ranks), result);
+
+    // A third pair can outrank the best single as kicker.
+    __m256i pair_hi = _mm256_sllv_epi32(one, entry_high(t_pairs));
+    __m256i pair_lo = _mm256_sllv_epi32(one,
+            _mm256_and_si256(_mm256_srli_epi32(t_pairs, 12), _mm256_set1_epi32(0xF)));
+    __m256i rest = _mm256_or_si256(_mm256_andnot_si256(_mm256_or_si256(pair_hi, pair_lo), pairs),
+            singles);
+    ranks = _mm256_or_si256(_mm256_and_si256(t_pairs, _mm256_set1_epi32(0xFF000)),
+            _mm256_slli_epi32(entry_high(gather_ranks(table, rest)), 8));
+    __m256i two_pairs = nonzero(_mm256_and_si256(pairs, _mm256_sub_epi32(pairs, one)));
+    result = select(two_pairs, with_category(TwoPair, ranks), result);
+
+    ranks = _mm256_or_si256(_mm256_slli_epi32(entry_high(t_trips), 16),
+            _mm256_and_si256(_mm256_srli_epi32(t_singles, 4), _mm256_set1_epi32(0xFF00)));
+    result = select(nonzero(trips), with_category(ThreeKind, ranks), result);
+
+    __m256i straight = _mm256_and_si256(_mm256_srli_epi32(t_all, CATEGORY_SHIFT), _mm256_set1_epi32(0xF));
+    ranks = _mm256_slli_epi32(_mm256_sub_epi32(straight, one), 16);
+    result = select(nonzero(straight), with_category(Straight, ranks), result);
+
+    result = select(nonzero(flush), with_category(Flush, _mm256_and_si256(t_flush, top_ranks)), result);
+
+    __m256i trip_hi = _mm256_sllv_epi32(one, entry_high(t_trips));
+    __m256i second = gather_ranks(table, _mm256_or_si256(_mm256_andnot_si256(trip_hi, trips), pairs));
+    ranks = _mm256_or_si256(_mm256_slli_epi32(entry_high(t_trips), 16),
+            _mm256_slli_epi32(entry_high(second), 12));
+    __m256i full = _mm256_and_si256(nonzero(trips), nonzero(_mm256_or_si256(pairs,
+                    _mm256_and_si256(trips, _mm256_sub_epi32(trips, one)))));
+    result = select(full, with_category(FullHouse, ranks), result);
+
+    __m256i kicker = gather_ranks(table, _mm256_andnot_si256(quads, all));
+    ranks = _mm256_or_si256(_mm256_slli_epi32(entry_high(t_quads), 16),
+            _mm256_slli_epi32(entry_high(kicker), 12));
+    result = select(nonzero(quads), with_category(FourKind, ranks), result);
+
+    __m256i flush_straight = _mm256_and_si256(_mm256_srli_epi32(t_flush, CATEGORY_SHIFT),
+            _mm256_set1_epi32(0xF));
+    ranks = _mm256_slli_epi32(_mm256_sub_epi32(flush_straight, one), 16);
+    __m256i royal = _mm256_cmpeq_epi32(flush_straight, _mm256_set1_epi32(NUM_RANKS));
+    __m256i cat = select(royal, _mm256_set1_epi32(RoyalFlush << CATEGORY_SHIFT),
+            _mm256_set1_epi32(StraightFlush << CATEGORY_SHIFT));
+    result = select(nonzero(flush_straight), _mm256_or_si256(cat, ranks), result);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(strengths), result);
+}
+#endif
+
+bool batch_simd() {
+#ifdef POKER_AVX2
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+#else
+    return false;
+#endif
+}
+
+void evaluate_batch(const card_t *cards, int count, std::size_t num_hands, strength_t *strengths) {
+    std::size_t first = 0;
+#ifdef POKER_AVX2
+    if (batch_simd()) {
+        for (; first + BATCH_SIZE <= num_hands; first += BATCH_SIZE) {
+            evaluate_avx2(cards + first, count, num_hands, strengths + first);
+        }
+    }
+#endif
+
+    card_t hand[7];
+    for (; first < num_hands; ++first) {
+        for (int j = 0; j < count; ++j) {
+            hand[j] = cards[j * num_hands + first];
+        }
+        strengths[first] = evaluate(hand, count);
+    }
+}
+
+std::vector<std::size_t> winners(const std::vector<strength_t> &strengths) {
+    std::vector<std::size_t> best;
+    for (std::size_t i = 0; i < strengths.size(); ++i) {
+        if (best.empty() || strengths[i] > strengths[best.front()]) {
+            best.clear();
+            best.push_back(i);
+        } else if (strengths[i] == strengths[best.front()]) {
+            best.push_back(i);
+        }
+    }
+
+    return best;
+}
+
+std::vector<std::size_t> showdown(const std::vector<std::vector<card_t> > &hands) {
+    std::vector<strength_t> strengths;
+    strengths.reserve(hands.size());
+    for (const std::vector<card_t> &hand : hands) {
+        strengths.push_back(evaluate(hand));
+    }
+
+    return winners(strengths);
+}
+
+} /* end util::poker */
+
+} /* end util:: */
@@ -0,0 +1,100 @@
+#ifndef _POKER_HPP_
+#define _POKER_HPP_
+
+/********************* Header Files ***********************/
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace util {
+
+namespace poker {
+
+/******************* Type Definitions *********************/
+// A card packed into one byte: rank * 4 + suit, rank 0 is the deuce.
+typedef std::uint8_t card_t;
+// Comparable strength of a hand, higher always wins, equal is a split.
+// Layout: category << 20 | up to five ranks as 4 bit nibbles, most significant first.
+typedef std::uint32_t strength_t;
+
+/******************* Constants/Macros *********************/
+// Same order as the Suits used by problem054.
+enum Suit {
+    Hearts,
+    Diamonds,
+    Clubs,
+    Spades,
+};
+// Same order as the HandTypes used by problem054.
+enum Category {
+    Unranked,
+    HighCard,
+    OnePair,
+    TwoPair,
+    ThreeKind,
+    Straight,
+    Flush,
+    FullHouse,
+    FourKind,
+    StraightFlush,
+    RoyalFlush,
+};
+
+static const int NUM_RANKS = 13;
+static const int NUM_SUITS = 4;
+static const int NUM_CARDS = NUM_RANKS * NUM_SUITS;
+static const int CATEGORY_SHIFT = 20;
+static const int NUM_CATEGORIES = RoyalFlush + 1;
+// Hands one AVX2 register evaluates at once.
+static const int BATCH_SIZE = 8;
+
+/************** Class & Func Declarations *****************/
+inline card_t make_card(int rank, int suit) {
+    return static_cast<card_t>(rank * NUM_SUITS + suit);
+}
+inline int card_rank(card_t card) { return card >> 2; }
+inline int card_suit(card_t card) { return card & 3; }
+inline Category category(strength_t strength) {
+    return static_cast<Category>(strength >> CATEGORY_SHIFT);
+}
+
+/* Parse the two chars at text into card, false if they aren't a card. No allocation. */
+bool parse_card(const char *text, card_t &card);
+/* Parse text like "TD" into a card, throws std::invalid_argument if malformed. */
+card_t parse_card(const std::string &text);
+/* Parse whitespace separated cards, i.e. "8C TS KC 9H 4S". */
+std::vector<card_t> parse_cards(const std::string &text);
+std::string card_text(card_t card);
+std::string category_text(Category cat);
+
+/* Highest rank of a 5 card run in the rank mask, ace may play low. -1 if none. */
+int straight_high(std::uint32_t rank_mask);
+
+/* Strength of the best 5 card hand among count cards, count must be 5 to 7. */
+strength_t evaluate(const card_t *cards, int count);
+inline strength_t evaluate(const std::vector<card_t> &cards) {
+    return evaluate(cards.data(), static_cast<int>(cards.size()));
+}
+
+/*
+ * Evaluate num_hands hands of count cards each (5 to 7), laid out as a struct of
+ * arrays: card j of hand i is cards[j * num_hands + i]. Runs BATCH_SIZE hands per
+ * step with AVX2 where the CPU has it, the scalar evaluate otherwise & for the remainder.
+ */
+void evaluate_batch(const card_t *cards, int count, std::size_t num_hands, strength_t *strengths);
+/* True when evaluate_batch takes the AVX2 path. */
+bool batch_simd();
+
+/* Indices of every strength equal to the best, more than one is a split pot. */
+std::vector<std::size_t> winners(const std::vector<strength_t> &strengths);
+/*
+ * Settle a pot among any number of hands of 5 to 7 cards each.
+ * Each hand is evaluated exactly once, then a single pass collects the winners.
+ */
+std::vector<std::size_t> showdown(const std::vector<std::vector<card_t> > &hands);
+
+} /* end util::poker */
+
+} /* end util:: */
+
+#endif /* _POKER_HPP_ */
@@ -0,0 +1,159 @@
+/**
+ * Test cases for the packed card poker evaluator
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "poker.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+namespace poker = util::poker;
+
+/************** Global Vars & Functions *******************/
+poker::strength_t eval_text(const std::string &text) {
+    return poker::evaluate(poker::parse_cards(text));
+}
+
+TEST(UtilPoker, ParseCard) {
+    poker::card_t card = poker::parse_card("TD");
+    ASSERT_EQ(poker::card_rank(card), 8);
+    ASSERT_EQ(poker::card_suit(card), poker::Diamonds);
+    ASSERT_EQ(poker::card_text(card), "TD");
+    ASSERT_EQ(poker::card_text(poker::parse_card("2H")), "2H");
+    ASSERT_EQ(poker::parse_card("AS"), poker::NUM_CARDS - 1);
+}
+
+TEST(UtilPoker, ParseCardInvalid) {
+    ASSERT_THROW(poker::parse_card("1H"), std::invalid_argument);
+    ASSERT_THROW(poker::parse_card("AX"), std::invalid_argument);
+    ASSERT_THROW(poker::parse_card("ACE"), std::invalid_argument);
+}
+
+TEST(UtilPoker, ParseCards) {
+    std::vector<poker::card_t> cards = poker::parse_cards("8C TS KC 9H 4S");
+    ASSERT_EQ(cards.size(), 5);
+    ASSERT_EQ(poker::card_text(cards.back()), "4S");
+}
+
+TEST(UtilPoker, StraightHigh) {
+    ASSERT_EQ(poker::straight_high(0x1F), 4);
+    ASSERT_EQ(poker::straight_high(0x1F00), 12);
+    // A 2 3 4 5, ace plays low
+    ASSERT_EQ(poker::straight_high(0x100F), 3);
+    ASSERT_EQ(poker::straight_high(0x0E0F), -1);
+}
+
+TEST(UtilPoker, Categories) {
+    ASSERT_EQ(poker::category(eval_text("2H 2D 4S 5C KC")), poker::OnePair);
+    ASSERT_EQ(poker::category(eval_text("2H 7D 4S 5C KC")), poker::HighCard);
+    ASSERT_EQ(poker::category(eval_text("2H 2D 5C 5S 9C")), poker::TwoPair);
+    ASSERT_EQ(poker::category(eval_text("2H 2D 2C 5C 9C")), poker::ThreeKind);
+    ASSERT_EQ(poker::category(eval_text("2H 3D 4S 5C 6C")), poker::Straight);
+    ASSERT_EQ(poker::category(eval_text("AH 2D 3S 4C 5C")), poker::Straight);
+    ASSERT_EQ(poker::category(eval_text("2H 6H 9H QH AH")), poker::Flush);
+    ASSERT_EQ(poker::category(eval_text("JH JD JC QH QD")), poker::FullHouse);
+    ASSERT_EQ(poker::category(eval_text("2H 2D 2C 2S 9C")), poker::FourKind);
+    ASSERT_EQ(poker::category(eval_text("5H 6H 7H 8H 9H")), poker::StraightFlush);
+    ASSERT_EQ(poker::category(eval_text("AH 2H 3H 4H 5H")), poker::StraightFlush);
+    ASSERT_EQ(poker::category(eval_text("TH JH QH KH AH")), poker::RoyalFlush);
+}
+
+TEST(UtilPoker, CompareKickers) {
+    ASSERT_GT(eval_text("QH QC 9H 6S 4D"), eval_text("QD QS 7H 6D 3D"));
+    ASSERT_GT(eval_text("2H 6H 9H QH AH"), eval_text("3D 6D 9D QD KD"));
+    ASSERT_GT(eval_text("2H 3D 4S 5C 6C"), eval_text("AH 2D 3S 4C 5C"));
+    ASSERT_EQ(eval_text("2H 2D 4S 4C KC"), eval_text("2C 2S 4H 4D KH"));
+}
+
+TEST(UtilPoker, SevenCards) {
+    // Best five ignore the weaker two pair & extra cards.
+    ASSERT_EQ(eval_text("AH AD KS KC QH QD 2C"), eval_text("AH AD KS KC QH"));
+    ASSERT_EQ(eval_text("AH AD AS KC KH QD QC"), eval_text("AH AD AS KC KH"));
+    ASSERT_EQ(eval_text("9H 9D 9S 8C 8H 8D 2C"), eval_text("9H 9D 9S 8C 8H"));
+    ASSERT_EQ(eval_text("7H 7D 7S 7C AH 2D 2C"), eval_text("7H 7D 7S 7C AS"));
+    ASSERT_EQ(eval_text("2H 5H 9H JH QH KH 3D"), eval_text("5H 9H JH QH KH"));
+    ASSERT_EQ(poker::category(eval_text("2H 3H 4H 5H 6H 7D 8D")), poker::StraightFlush);
+    ASSERT_EQ(poker::category(eval_text("2H 3H 4H 5H 9H 6D 7D")), poker::Flush);
+}
+
+TEST(UtilPoker, Winners) {
+    std::vector<poker::strength_t> strengths = {5, 9, 3, 9, 1};
+    std::vector<std::size_t> expect = {1, 3};
+    ASSERT_EQ(poker::winners(strengths), expect);
+    ASSERT_TRUE(poker::winners(std::vector<poker::strength_t>()).empty());
+}
+
+TEST(UtilPoker, ShowdownSplit) {
+    // Board plays for three of four players.
+    std::vector<std::vector<poker::card_t> > hands;
+    for (const char *hole : {"2H 3D", "AH 9C", "2C 4S", "3C 5S"}) {
+        hands.push_back(poker::parse_cards(std::string(hole) + " TS JS QD KC 7H"));
+    }
+    std::vector<std::size_t> expect = {1};
+    ASSERT_EQ(poker::showdown(hands), expect);
+
+    hands[1] = poker::parse_cards("8H 9C TS JS QD KC 7H");
+    hands.push_back(poker::parse_cards("8D 9D TS JS QD KC 7H"));
+    expect = {1, 4};
+    ASSERT_EQ(poker::showdown(hands), expect);
+}
+
+TEST(UtilPoker, EvaluateBatch) {
+    // Odd hand count so both the vector steps & the scalar remainder run.
+    const std::size_t num_hands = 4 * poker::BATCH_SIZE + 3;
+    std::mt19937 rng(5489);
+    std::vector<poker::card_t> deck;
+    for (int card = 0; card < poker::NUM_CARDS; ++card) {
+        deck.push_back(card);
+    }
+
+    for (int count = 5; count <= 7; ++count) {
+        for (int round = 0; round < 50; ++round) {
+            std::vector<poker::card_t> cards(count * num_hands);
+            std::vector<poker::strength_t> expect(num_hands);
+            for (std::size_t i = 0; i < num_hands; ++i) {
+                std::shuffle(deck.begin(), deck.end(), rng);
+                for (int j = 0; j < count; ++j) {
+                    cards[j * num_hands + i] = deck[j];
+                }
+                expect[i] = poker::evaluate(deck.data(), count);
+            }
+
+            std::vector<poker::strength_t> strengths(num_hands);
+            poker::evaluate_batch(cards.data(), count, num_hands, strengths.data());
+            ASSERT_EQ(strengths, expect);
+        }
+    }
+}
+
+TEST(UtilPoker, EvaluateBatchCategories) {
+    const std::vector<std::string> hands = {
+        "2H 4D 6S 8C TC", "2H 2D 4S 5C 9C", "2H 2D 5C 5S 9C", "2H 2D 5C 5S 9C 9D KH",
+        "2H 2D 2C 5C 9C", "AH 2D 3S 4C 5C", "2H 6H 9H QH AH", "JH JD JC QH QD",
+        "JH JD JC QH QD QS", "2H 2D 2C 2S 9C", "AH 2H 3H 4H 5H", "TH JH QH KH AH 9H",
+    };
+    for (const std::string &text : hands) {
+        std::vector<poker::card_t> hand = poker::parse_cards(text);
+        const int count = hand.size();
+        // Same hand in every lane, each lane rotated to a different card order.
+        std::vector<poker::card_t> cards(count * poker::BATCH_SIZE);
+        for (int i = 0; i < poker::BATCH_SIZE; ++i) {
+            for (int j = 0; j < count; ++j) {
+                cards[j * poker::BATCH_SIZE + i] = hand[(i + j) % count];
+            }
+        }
+
+        std::vector<poker::strength_t> strengths(poker::BATCH_SIZE);
+        poker::evaluate_batch(cards.data(), count, poker::BATCH_SIZE, strengths.data());
+        for (poker::strength_t strength : strengths) {
+            ASSERT_EQ(strength, poker::evaluate(hand)) << text;
+        }
+    }
+}
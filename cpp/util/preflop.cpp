@@ -0,0 +1,245 @@
+/**
+ * Exact heads up preflop equity between starting hand classes, with an on disk table.
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <thread>
+
+#include "equity.hpp"
+#include "preflop.hpp"
+
+namespace util {
+
+namespace poker {
+
+/***************** Constants & Macros *********************/
+static const std::string CLASS_RANKS = "AKQJT98765432";
+static const std::uint32_t PREFLOP_MAGIC = 0x51454650; // "PFEQ" little endian
+static const std::uint32_t PREFLOP_PLAYERS = 2;
+static const std::size_t TABLE_CELLS = NUM_CLASSES * NUM_CLASSES;
+
+/******************* Type Definitions *********************/
+struct PreflopHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t classes;
+    std::uint32_t players;
+};
+
+/************** Global Vars & Functions *******************/
+inline int grid_index(card_t card) {
+    return NUM_RANKS - 1 - card_rank(card);
+}
+
+int hand_class(card_t first, card_t second) {
+    int high = std::min(grid_index(first), grid_index(second));
+    int low = std::max(grid_index(first), grid_index(second));
+    if (card_suit(first) == card_suit(second) && high != low) {
+        return high * NUM_RANKS + low;
+    }
+    return low * NUM_RANKS + high;
+}
+
+int parse_class(const std::string &text) {
+    std::size_t high = text.size() >= 2 ? CLASS_RANKS.find(text[0]) : std::string::npos;
+    std::size_t low = text.size() >= 2 ? CLASS_RANKS.find(text[1]) : std::string::npos;
+    if (high == std::string::npos || low == std::string::npos) {
+        throw std::invalid_argument("Malformed hand class: " + text);
+    }
+    if (high > low) {
+        std::swap(high, low);
+    }
+
+    if (high == low && text.size() == 2) {
+        return high * NUM_RANKS + low;
+    } else if (high != low && text.size() == 3 && text[2] == 's') {
+        return high * NUM_RANKS + low;
+    } else if (high != low && text.size() == 3 && text[2] == 'o') {
+        return low * NUM_RANKS + high;
+    }
+    throw std::invalid_argument("Malformed hand class: " + text);
+}
+
+std::string class_text(int hand_class) {
+    int row = hand_class / NUM_RANKS, col = hand_class % NUM_RANKS;
+    std::string text = {CLASS_RANKS[std::min(row, col)], CLASS_RANKS[std::max(row, col)]};
+    if (row < col) {
+        text += 's';
+    } else if (row > col) {
+        text += 'o';
+    }
+    return text;
+}
+
+std::vector<std::pair<card_t, card_t> > class_combos(int hand_class) {
+    int row = hand_class / NUM_RANKS, col = hand_class % NUM_RANKS;
+    int high = NUM_RANKS - 1 - std::min(row, col), low = NUM_RANKS - 1 - std::max(row, col);
+
+    std::vector<std::pair<card_t, card_t> > combos;
+    for (int first = 0; first < NUM_SUITS; ++first) {
+        for (int second = 0; second < NUM_SUITS; ++second) {
+            bool keep = row == col ? first < second : (row < col) == (first == second);
+            if (keep) {
+                combos.push_back(std::make_pair(make_card(high, first), make_card(low, second)));
+            }
+        }
+    }
+
+    return combos;
+}
+
+/* Smallest packing of both hands over every relabeling of the suits. */
+std::uint32_t canonical_deal(card_t hero_a, card_t hero_b, card_t vill_a, card_t vill_b) {
+    int perm[NUM_SUITS] = {0, 1, 2, 3};
+    std::uint32_t best = std::numeric_limits<std::uint32_t>::max();
+    do {
+        card_t cards[4] = {hero_a, hero_b, vill_a, vill_b};
+        for (card_t &card : cards) {
+            card = make_card(card_rank(card), perm[card_suit(card)]);
+        }
+        if (cards[0] < cards[1]) {
+            std::swap(cards[0], cards[1]);
+        }
+        if (cards[2] < cards[3]) {
+            std::swap(cards[2], cards[3]);
+        }
+        std::uint32_t packed = cards[0] << 24 | cards[1] << 16 | cards[2] << 8 | cards[3];
+        best = std::min(best, packed);
+    } while (std::next_permutation(perm, perm + NUM_SUITS));
+
+    return best;
+}
+
+double class_equity(int hero, int villain, unsigned threads) {
+    // Distinct deals up to suit, with how many concrete deals each one stands for.
+    std::map<std::uint32_t, int> deals;
+    int total = 0;
+    for (const auto &hero_combo : class_combos(hero)) {
+        for (const auto &vill_combo : class_combos(villain)) {
+            if (hero_combo.first == vill_combo.first || hero_combo.first == vill_combo.second ||
+                    hero_combo.second == vill_combo.first || hero_combo.second == vill_combo.second) {
+                continue;
+            }
+            ++deals[canonical_deal(hero_combo.first, hero_combo.second,
+                    vill_combo.first, vill_combo.second)];
+            ++total;
+        }
+    }
+
+    EquityConfig config;
+    config.threads = threads;
+    config.exact_limit = std::numeric_limits<std::uint64_t>::max();
+
+    double sum = 0.0;
+    for (const auto &deal : deals) {
+        std::vector<hole_t> holes = {
+            hole_t {{static_cast<card_t>(deal.first >> 24), static_cast<card_t>(deal.first >> 16)}},
+            hole_t {{static_cast<card_t>(deal.first >> 8), static_cast<card_t>(deal.first)}},
+        };
+        sum += calc_equity(holes, std::vector<card_t>(), config).equity[0] * deal.second;
+    }
+
+    return sum / total;
+}
+
+PreflopTable::PreflopTable(const std::string &filename) :
+        mapped(new MappedFile(filename)), cells(NULL) {
+    PreflopHeader header;
+    if (mapped->size() != sizeof(header) + TABLE_CELLS * sizeof(float)) {
+        throw std::runtime_error("Preflop table has the wrong size: " + filename);
+    }
+
+    std::memcpy(&header, mapped->data(), sizeof(header));
+    if (header.magic != PREFLOP_MAGIC || header.version != PREFLOP_VERSION ||
+            header.classes != static_cast<std::uint32_t>(NUM_CLASSES) ||
+            header.players != PREFLOP_PLAYERS) {
+        throw std::runtime_error("Preflop table header mismatch: " + filename);
+    }
+    // Page aligned map & a 16 byte header keep the floats aligned.
+    cells = reinterpret_cast<const float *>(mapped->data() + sizeof(header));
+}
+
+PreflopTable::PreflopTable(const std::vector<float> &table) : owned(table), cells(NULL) {
+    if (owned.size() != TABLE_CELLS) {
+        throw std::invalid_argument("Preflop table must have NUM_CLASSES squared cells.");
+    }
+    cells = owned.data();
+}
+
+std::vector<float> PreflopTable::compute(unsigned threads, int num_classes) {
+    std::vector<float> table(TABLE_CELLS, 0.0f);
+    // Equity of a class against itself is a coin flip by symmetry.
+    for (int hand = 0; hand < num_classes; ++hand) {
+        table[hand * NUM_CLASSES + hand] = 0.5f;
+    }
+
+    // Only the upper triangle is enumerated, the mirror cell is the complement.
+    std::vector<std::pair<int, int> > cells;
+    for (int hero = 0; hero < num_classes; ++hero) {
+        for (int villain = hero + 1; villain < num_classes; ++villain) {
+            cells.push_back(std::make_pair(hero, villain));
+        }
+    }
+
+    threads = threads ? threads : std::thread::hardware_concurrency();
+    threads = std::max(1u, std::min<unsigned>(threads, std::max<std::size_t>(1, cells.size())));
+    std::atomic<std::size_t> next_cell(0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&cells, &next_cell, &table]() {
+            std::size_t cell;
+            while ((cell = next_cell.fetch_add(1)) < cells.size()) {
+                int hero = cells[cell].first, villain = cells[cell].second;
+                double equity = class_equity(hero, villain, 1);
+                table[hero * NUM_CLASSES + villain] = static_cast<float>(equity);
+                table[villain * NUM_CLASSES + hero] = static_cast<float>(1.0 - equity);
+            }
+        }));
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    return table;
+}
+
+void PreflopTable::save(const std::string &filename, const std::vector<float> &table) {
+    if (table.size() != TABLE_CELLS) {
+        throw std::invalid_argument("Preflop table must have NUM_CLASSES squared cells.");
+    }
+
+    // Write beside the target then rename, a reader never maps half a table.
+    std::string temp = filename + ".tmp";
+    std::ofstream fout(temp.c_str(), std::ios::binary | std::ios::trunc);
+    PreflopHeader header = {PREFLOP_MAGIC, PREFLOP_VERSION,
+        static_cast<std::uint32_t>(NUM_CLASSES), PREFLOP_PLAYERS};
+    fout.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    fout.write(reinterpret_cast<const char *>(table.data()), table.size() * sizeof(float));
+    fout.close();
+    if (!fout || std::rename(temp.c_str(), filename.c_str()) != 0) {
+        std::remove(temp.c_str());
+        throw std::runtime_error("Unable to write preflop table: " + filename);
+    }
+}
+
+std::unique_ptr<PreflopTable> PreflopTable::load_or_compute(const std::string &filename,
+        unsigned threads) {
+    try {
+        return std::unique_ptr<PreflopTable>(new PreflopTable(filename));
+    } catch (std::runtime_error &) {
+        save(filename, compute(threads));
+        return std::unique_ptr<PreflopTable>(new PreflopTable(filename));
+    }
+}
+
+} /* end util::poker */
+
+} /* end util:: */
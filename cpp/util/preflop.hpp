@@ -0,0 +1,76 @@
+#ifndef _PREFLOP_HPP_
+#define _PREFLOP_HPP_
+
+/********************* Header Files ***********************/
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mapped_file.hpp"
+#include "poker.hpp"
+
+namespace util {
+
+namespace poker {
+
+/******************* Constants/Macros *********************/
+// Starting hands up to suit, laid out on the usual 13x13 grid with aces first:
+// pairs on the diagonal, suited above it & offsuit below it.
+static const int NUM_CLASSES = NUM_RANKS * NUM_RANKS;
+static const std::uint32_t PREFLOP_VERSION = 1;
+
+/************** Class & Func Declarations *****************/
+int hand_class(card_t first, card_t second);
+/* Text like "AA", "AKs" or "72o" to a class, throws std::invalid_argument if malformed. */
+int parse_class(const std::string &text);
+std::string class_text(int hand_class);
+/* Every concrete pair of hole cards in the class. */
+std::vector<std::pair<card_t, card_t> > class_combos(int hand_class);
+
+/*
+ * Exact heads up equity of hero's class against villain's class, averaged
+ * over every pair of combos that share no card. Combos the same up to a suit
+ * relabeling are only enumerated once.
+ */
+double class_equity(int hero, int villain, unsigned threads = 1);
+
+/*
+ * Heads up preflop equity table, NUM_CLASSES squared floats of hero's equity.
+ * Loaded tables are memory mapped so lookups read the file directly.
+ */
+class PreflopTable {
+public:
+    // Map a saved table, throws std::runtime_error if missing, truncated or from another version.
+    explicit PreflopTable(const std::string &filename);
+    // Use a table already in memory.
+    explicit PreflopTable(const std::vector<float> &table);
+
+    /*
+     * Enumerate every cell across threads, 0 uses all hardware threads.
+     * Only cells among the first num_classes classes are computed, the rest stay 0.
+     */
+    static std::vector<float> compute(unsigned threads = 0, int num_classes = NUM_CLASSES);
+    static void save(const std::string &filename, const std::vector<float> &table);
+    // Map filename if it holds a valid table, otherwise compute, save & map it.
+    static std::unique_ptr<PreflopTable> load_or_compute(const std::string &filename,
+            unsigned threads = 0);
+
+    float equity(int hero, int villain) const {
+        return cells[hero * NUM_CLASSES + villain];
+    }
+    float equity(const std::string &hero, const std::string &villain) const {
+        return equity(parse_class(hero), parse_class(villain));
+    }
+
+private:
+    std::unique_ptr<MappedFile> mapped;
+    std::vector<float> owned;
+    const float *cells;
+};
+
+} /* end util::poker */
+
+} /* end util:: */
+
+#endif /* _PREFLOP_HPP_ */
@@ -0,0 +1,90 @@
+/**
+ * Test cases for the preflop equity table
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <fstream>
+#include <stdexcept>
+#include <cstdio>
+
+#include "gtest/gtest.h"
+#include "preflop.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+namespace poker = util::poker;
+
+/************** Global Vars & Functions *******************/
+static const std::string PREFLOP_FNAME = "/tmp/util_preflop_test.bin";
+
+TEST(UtilPreflop, HandClass) {
+    ASSERT_EQ(poker::parse_class("AA"), 0);
+    ASSERT_EQ(poker::parse_class("AKs"), 1);
+    ASSERT_EQ(poker::parse_class("KAo"), poker::NUM_RANKS);
+    ASSERT_EQ(poker::parse_class("22"), poker::NUM_CLASSES - 1);
+    ASSERT_EQ(poker::hand_class(poker::parse_card("7S"), poker::parse_card("2S")),
+            poker::parse_class("72s"));
+    ASSERT_EQ(poker::hand_class(poker::parse_card("2D"), poker::parse_card("7S")),
+            poker::parse_class("72o"));
+    ASSERT_THROW(poker::parse_class("AAs"), std::invalid_argument);
+    ASSERT_THROW(poker::parse_class("AK"), std::invalid_argument);
+    ASSERT_THROW(poker::parse_class("A1o"), std::invalid_argument);
+
+    for (int hand = 0; hand < poker::NUM_CLASSES; ++hand) {
+        ASSERT_EQ(poker::parse_class(poker::class_text(hand)), hand);
+    }
+}
+
+TEST(UtilPreflop, ClassCombos) {
+    int total = 0;
+    for (int hand = 0; hand < poker::NUM_CLASSES; ++hand) {
+        for (const auto &combo : poker::class_combos(hand)) {
+            ASSERT_EQ(poker::hand_class(combo.first, combo.second), hand);
+            ++total;
+        }
+    }
+    ASSERT_EQ(total, 1326);
+    ASSERT_EQ(poker::class_combos(poker::parse_class("QQ")).size(), 6);
+    ASSERT_EQ(poker::class_combos(poker::parse_class("QJs")).size(), 4);
+    ASSERT_EQ(poker::class_combos(poker::parse_class("QJo")).size(), 12);
+}
+
+TEST(UtilPreflop, ClassEquity) {
+    double equity = poker::class_equity(poker::parse_class("AA"), poker::parse_class("KK"));
+    ASSERT_NEAR(equity, 0.8195, 0.001);
+}
+
+TEST(UtilPreflop, ComputeAndMap) {
+    std::vector<float> table = poker::PreflopTable::compute(2, 2);
+    ASSERT_FLOAT_EQ(table[0], 0.5f);
+    ASSERT_NEAR(table[1], 0.87, 0.01);
+    ASSERT_FLOAT_EQ(table[1] + table[poker::NUM_CLASSES], 1.0f);
+
+    poker::PreflopTable::save(PREFLOP_FNAME, table);
+    poker::PreflopTable mapped(PREFLOP_FNAME);
+    ASSERT_FLOAT_EQ(mapped.equity("AA", "AKs"), table[1]);
+    ASSERT_FLOAT_EQ(mapped.equity("AKs", "AA"), table[poker::NUM_CLASSES]);
+    ASSERT_FLOAT_EQ(mapped.equity("72o", "32o"), 0.0f);
+    std::remove(PREFLOP_FNAME.c_str());
+}
+
+TEST(UtilPreflop, RejectsStaleFile) {
+    std::ofstream(PREFLOP_FNAME) << "not a table";
+    ASSERT_THROW(poker::PreflopTable table(PREFLOP_FNAME), std::runtime_error);
+
+    // Right size but another version.
+    std::vector<float> table(poker::NUM_CLASSES * poker::NUM_CLASSES, 0.25f);
+    poker::PreflopTable::save(PREFLOP_FNAME, table);
+    {
+        std::fstream file(PREFLOP_FNAME, std::ios::in | std::ios::out | std::ios::binary);
+        std::uint32_t version = poker::PREFLOP_VERSION + 1;
+        file.seekp(sizeof(std::uint32_t));
+        file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    }
+    ASSERT_THROW(poker::PreflopTable table(PREFLOP_FNAME), std::runtime_error);
+    std::remove(PREFLOP_FNAME.c_str());
+
+    ASSERT_THROW(poker::PreflopTable(std::vector<float>(3)), std::invalid_argument);
+}
@@ -0,0 +1,94 @@
+#ifndef _RADIX_HEAP_HPP_
+#define _RADIX_HEAP_HPP_
+
+/********************* Header Files ***********************/
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+/************** Class & Func Declarations *****************/
+/*
+ * Monotone min priority queue on 32 bit keys: no key pushed may be below the
+ * last one popped, which always holds for Dijkstra with non negative weights.
+ * Bucket b holds keys whose highest bit differing from the last popped key is
+ * bit b - 1, so each entry moves down at most 32 times before it is popped.
+ */
+template <class Value>
+class RadixHeap {
+public:
+    typedef std::pair<std::uint32_t, Value> value_type;
+
+    RadixHeap() : count(0), last(0) {}
+
+    /* Throws std::invalid_argument if key is below the last key popped. */
+    void push(std::uint32_t key, const Value &value) {
+        if (key < last) {
+            throw std::invalid_argument("RadixHeap keys must not go below the last popped.");
+        }
+        buckets[bucket_of(key)].push_back(value_type(key, value));
+        ++count;
+    }
+    /* Remove & return an entry with the least key, the heap must not be empty. */
+    value_type pop() {
+        if (buckets[0].empty()) {
+            refill();
+        }
+        value_type top = buckets[0].back();
+        buckets[0].pop_back();
+        --count;
+
+        return top;
+    }
+    std::uint32_t top_key() {
+        if (buckets[0].empty()) {
+            refill();
+        }
+        return last;
+    }
+
+    void clear() {
+        for (std::vector<value_type> &bucket : buckets) {
+            bucket.clear();
+        }
+        count = 0;
+        last = 0;
+    }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    static constexpr int NUM_BUCKETS = 33;
+
+    std::size_t bucket_of(std::uint32_t key) const {
+        return key == last ? 0 : 32 - __builtin_clz(key ^ last);
+    }
+    /* Bucket 0 is empty, move the least key of the next bucket to last & spread that bucket below. */
+    void refill() {
+        std::size_t index = 1;
+        while (buckets[index].empty()) {
+            ++index;
+        }
+
+        std::vector<value_type> &bucket = buckets[index];
+        last = std::min_element(bucket.begin(), bucket.end(),
+                [](const value_type &left, const value_type &right) {
+            return left.first < right.first;
+        })->first;
+        for (const value_type &entry : bucket) {
+            buckets[bucket_of(entry.first)].push_back(entry);
+        }
+        bucket.clear();
+    }
+
+    std::vector<value_type> buckets[NUM_BUCKETS];
+    std::size_t count;
+    std::uint32_t last;
+};
+
+} /* end util:: */
+
+#endif /* _RADIX_HEAP_HPP_ */
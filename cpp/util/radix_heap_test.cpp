@@ -0,0 +1,65 @@
+/**
+ * Test cases for the monotone radix heap
+ */
+/********************* Header Files ***********************/
+/* C++ Headers */
+#include <iostream> /* Input/output objects. */
+#include <functional>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "radix_heap.hpp"
+
+/**************** Namespace Declarations ******************/
+using std::cout;
+using std::endl;
+
+/************** Global Vars & Functions *******************/
+TEST(UtilRadixHeap, PushPop) {
+    util::RadixHeap<char> heap;
+    ASSERT_TRUE(heap.empty());
+    heap.push(7, 'a');
+    heap.push(3, 'b');
+    heap.push(12, 'c');
+    heap.push(3, 'd');
+    ASSERT_EQ(heap.size(), 4);
+
+    ASSERT_EQ(heap.top_key(), 3);
+    ASSERT_EQ(heap.pop().first, 3);
+    ASSERT_EQ(heap.pop().first, 3);
+    ASSERT_EQ(heap.pop(), std::make_pair(7u, 'a'));
+    ASSERT_THROW(heap.push(6, 'e'), std::invalid_argument);
+    heap.push(7, 'f');
+    ASSERT_EQ(heap.pop(), std::make_pair(7u, 'f'));
+    ASSERT_EQ(heap.pop(), std::make_pair(12u, 'c'));
+    ASSERT_TRUE(heap.empty());
+}
+
+TEST(UtilRadixHeap, MatchesPriorityQueue) {
+    typedef std::priority_queue<std::uint32_t, std::vector<std::uint32_t>, std::greater<std::uint32_t>> min_queue;
+    std::mt19937 gen(46);
+    std::uniform_int_distribution<std::uint32_t> step(0, 5000);
+    util::RadixHeap<int> heap;
+    min_queue expect;
+
+    std::uint32_t last = 0;
+    for (int round = 0; round < 20000; ++round) {
+        if (expect.empty() || gen() % 3) {
+            std::uint32_t key = last + step(gen) * (gen() % 4 ? 1 : 1000);
+            heap.push(key, round);
+            expect.push(key);
+        } else {
+            last = heap.pop().first;
+            ASSERT_EQ(last, expect.top());
+            expect.pop();
+        }
+    }
+    while (!expect.empty()) {
+        ASSERT_EQ(heap.pop().first, expect.top());
+        expect.pop();
+    }
+    ASSERT_TRUE(heap.empty());
+}